@@ -7,10 +7,21 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/abstractData.h"
+#include "pxr/sdf/payload.h"
+#include "pxr/sdf/reference.h"
+#include "pxr/sdf/schema.h"
+#include <pxr/tf/type.h>
 #include <pxr/trace/trace.h>
+#include <pxr/vt/dictionary.h>
+#include <pxr/work/loops.h>
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <atomic>
 #include <cmath>
 #include <ostream>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -421,6 +432,310 @@ SdfAbstractData::ListDictKeys(const SdfPath &path,
 }
 
 
+// Visitor that collects the paths of all prim and variant specs.
+struct SdfAbstractData_PrimSpecPathCollector
+    : public SdfAbstractDataSpecVisitor
+{
+    virtual bool VisitSpec(const SdfAbstractData& data, const SdfPath &path)
+    {
+        const SdfSpecType specType = data.GetSpecType(path);
+        if (specType == SdfSpecTypePrim || specType == SdfSpecTypeVariant) {
+            paths.push_back(path);
+        }
+        return true;
+    }
+
+    virtual void Done(const SdfAbstractData&)
+    {
+        // Do nothing
+    }
+
+    SdfPathVector paths;
+};
+
+std::set<std::string>
+SdfAbstractData::GetCompositionAssetDependencies() const
+{
+    TRACE_FUNCTION();
+
+    std::set<std::string> result;
+    _AddCompositionAssetDependencies(
+        SdfFieldKeys->SubLayers,
+        Get(SdfPath::AbsoluteRootPath(), SdfFieldKeys->SubLayers), &result);
+
+    SdfAbstractData_PrimSpecPathCollector collector;
+    VisitSpecs(&collector);
+
+    tbb::enumerable_thread_specific<std::set<std::string>> assetPaths;
+    WorkParallelForN(
+        collector.paths.size(),
+        [this, &collector, &assetPaths](size_t begin, size_t end) {
+            std::set<std::string> &local = assetPaths.local();
+            VtValue value;
+            for (size_t i = begin; i != end; ++i) {
+                const SdfPath &path = collector.paths[i];
+                if (Has(path, SdfFieldKeys->References, &value)) {
+                    _AddCompositionAssetDependencies(
+                        SdfFieldKeys->References, value, &local);
+                }
+                if (Has(path, SdfFieldKeys->Payload, &value)) {
+                    _AddCompositionAssetDependencies(
+                        SdfFieldKeys->Payload, value, &local);
+                }
+            }
+        });
+
+    for (const std::set<std::string> &local : assetPaths) {
+        result.insert(local.begin(), local.end());
+    }
+    return result;
+}
+
+void
+SdfAbstractData::_AddCompositionAssetDependencies(
+    const TfToken &fieldName, const VtValue &value,
+    std::set<std::string> *assetPaths)
+{
+    if (fieldName == SdfFieldKeys->References) {
+        if (value.IsHolding<SdfReferenceListOp>()) {
+            for (const SdfReference &ref :
+                     value.UncheckedGet<SdfReferenceListOp>()
+                         .GetAppliedItems()) {
+                assetPaths->insert(ref.GetAssetPath());
+            }
+        }
+    }
+    else if (fieldName == SdfFieldKeys->Payload) {
+        if (value.IsHolding<SdfPayloadListOp>()) {
+            for (const SdfPayload &payload :
+                     value.UncheckedGet<SdfPayloadListOp>()
+                         .GetAppliedItems()) {
+                assetPaths->insert(payload.GetAssetPath());
+            }
+        }
+        else if (value.IsHolding<SdfPayload>()) {
+            // Older data may hold a single payload, where an empty asset path
+            // means an explicitly empty payload list.
+            const SdfPayload &payload = value.UncheckedGet<SdfPayload>();
+            if (!payload.GetAssetPath().empty()) {
+                assetPaths->insert(payload.GetAssetPath());
+            }
+        }
+    }
+    else if (fieldName == SdfFieldKeys->SubLayers) {
+        if (value.IsHolding<std::vector<std::string>>()) {
+            const std::vector<std::string> &subLayers =
+                value.UncheckedGet<std::vector<std::string>>();
+            assetPaths->insert(subLayers.begin(), subLayers.end());
+        }
+    }
+}
+
+struct SdfAbstractData_SpecPathCollector : public SdfAbstractDataSpecVisitor
+{
+    virtual bool VisitSpec(
+        const SdfAbstractData& data, const SdfPath& path)
+    {
+        paths.push_back(path);
+        return true;
+    }
+
+    virtual void Done(const SdfAbstractData&)
+    {
+        // Do nothing
+    }
+
+    SdfPathVector paths;
+};
+
+SdfAbstractDataMemoryUsage
+SdfAbstractData::GetMemoryUsage() const
+{
+    TRACE_FUNCTION();
+
+    SdfAbstractData_SpecPathCollector collector;
+    VisitSpecs(&collector);
+
+    tbb::enumerable_thread_specific<SdfAbstractDataMemoryUsage> usages;
+    WorkParallelForN(
+        collector.paths.size(),
+        [this, &collector, &usages](size_t begin, size_t end) {
+            SdfAbstractDataMemoryUsage &local = usages.local();
+            for (size_t i = begin; i != end; ++i) {
+                const SdfPath &path = collector.paths[i];
+                const std::vector<TfToken> fields = List(path);
+                local.fieldBytes +=
+                    fields.size() * sizeof(std::pair<TfToken, VtValue>);
+                for (const TfToken &field : fields) {
+                    _AddValueMemoryUsage(Get(path, field), &local);
+                }
+            }
+        });
+
+    SdfAbstractDataMemoryUsage result;
+    result.specTableBytes = collector.paths.size() *
+        (sizeof(SdfPath) + sizeof(SdfSpecType));
+    for (const SdfAbstractDataMemoryUsage &local : usages) {
+        result += local;
+    }
+    return result;
+}
+
+// The epoch starts at one, so that zero can mean "never accessed".
+static std::atomic<size_t> Sdf_accessEpoch{1};
+
+bool
+SdfAbstractData::PageOut()
+{
+    return false;
+}
+
+bool
+SdfAbstractData::IsPagedOut() const
+{
+    return false;
+}
+
+size_t
+SdfAbstractData::GetLastAccessEpoch() const
+{
+    return 0;
+}
+
+void
+SdfAbstractData::ResetAccessTracking() const
+{
+}
+
+size_t
+SdfAbstractData::GetAccessEpoch()
+{
+    return Sdf_accessEpoch.load(std::memory_order_relaxed);
+}
+
+size_t
+SdfAbstractData::AdvanceAccessEpoch()
+{
+    return ++Sdf_accessEpoch;
+}
+
+// Return the size of the type \p typeInfo.  Memory usage is gathered in
+// parallel over many values of a few types, so cache the TfType lookups per
+// thread rather than contend on the type registry for every value.
+static size_t
+Sdf_GetSizeof(const std::type_info &typeInfo)
+{
+    thread_local std::unordered_map<std::type_index, size_t> sizes;
+    auto it = sizes.find(typeInfo);
+    if (it == sizes.end()) {
+        it = sizes.emplace(
+            typeInfo, TfType::Find(typeInfo).GetSizeof()).first;
+    }
+    return it->second;
+}
+
+size_t
+SdfAbstractData::_GetValueHeapBytes(const VtValue &value)
+{
+    if (value.IsEmpty()) {
+        return 0;
+    }
+
+    // VtValue stores small trivially copyable types locally and everything
+    // else in a separate heap allocation.
+    size_t bytes = 0;
+    const size_t typeSize = Sdf_GetSizeof(value.GetTypeid());
+    if (typeSize > sizeof(void *)) {
+        bytes += typeSize;
+    }
+
+    if (value.IsArrayValued()) {
+        bytes += value.GetArraySize() *
+            Sdf_GetSizeof(value.GetElementTypeid());
+    }
+    else if (value.IsHolding<std::string>()) {
+        bytes += value.UncheckedGet<std::string>().capacity();
+    }
+    else if (value.IsHolding<VtDictionary>()) {
+        for (const auto &entry : value.UncheckedGet<VtDictionary>()) {
+            bytes += sizeof(VtDictionary::value_type) +
+                entry.first.capacity() + _GetValueHeapBytes(entry.second);
+        }
+    }
+    else if (value.IsHolding<SdfTimeSampleMap>()) {
+        for (const auto &sample : value.UncheckedGet<SdfTimeSampleMap>()) {
+            bytes += sizeof(SdfTimeSampleMap::value_type) +
+                _GetValueHeapBytes(sample.second);
+        }
+    }
+    else if (value.IsHolding<TfTokenVector>()) {
+        bytes += value.UncheckedGet<TfTokenVector>().capacity() *
+            sizeof(TfToken);
+    }
+    else if (value.IsHolding<SdfPathVector>()) {
+        bytes += value.UncheckedGet<SdfPathVector>().capacity() *
+            sizeof(SdfPath);
+    }
+    else if (value.IsHolding<std::vector<std::string>>()) {
+        const std::vector<std::string> &strings =
+            value.UncheckedGet<std::vector<std::string>>();
+        bytes += strings.capacity() * sizeof(std::string);
+        for (const std::string &str : strings) {
+            bytes += str.capacity();
+        }
+    }
+    return bytes;
+}
+
+void
+SdfAbstractData::_AddValueMemoryUsage(
+    const VtValue &value, SdfAbstractDataMemoryUsage *usage)
+{
+    if (value.IsEmpty()) {
+        return;
+    }
+    if (value.IsHolding<SdfTimeSampleMap>()) {
+        usage->timeSampleBytes += _GetValueHeapBytes(value);
+    }
+    else {
+        usage->valueBytesByType[value.GetTypeName()] +=
+            _GetValueHeapBytes(value);
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+size_t
+SdfAbstractDataMemoryUsage::GetValueBytes() const
+{
+    size_t bytes = 0;
+    for (const auto &entry : valueBytesByType) {
+        bytes += entry.second;
+    }
+    return bytes;
+}
+
+size_t
+SdfAbstractDataMemoryUsage::GetTotalBytes() const
+{
+    return specTableBytes + fieldBytes + GetValueBytes() +
+        timeSampleBytes + structuralBytes;
+}
+
+SdfAbstractDataMemoryUsage &
+SdfAbstractDataMemoryUsage::operator+=(const SdfAbstractDataMemoryUsage &other)
+{
+    specTableBytes += other.specTableBytes;
+    fieldBytes += other.fieldBytes;
+    for (const auto &entry : other.valueBytesByType) {
+        valueBytesByType[entry.first] += entry.second;
+    }
+    timeSampleBytes += other.timeSampleBytes;
+    mappedBytes += other.mappedBytes;
+    structuralBytes += other.structuralBytes;
+    return *this;
+}
+
 ////////////////////////////////////////////////////////////
 
 SdfAbstractDataSpecVisitor::~SdfAbstractDataSpecVisitor()
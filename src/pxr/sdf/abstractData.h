@@ -20,6 +20,9 @@
 #include <pxr/tf/weakBase.h>
 #include <pxr/tf/declarePtrs.h>
 
+#include <map>
+#include <set>
+#include <string>
 #include <vector>
 #include <type_traits>
 
@@ -36,6 +39,54 @@ class SdfAbstractDataValue;
 
 TF_DECLARE_PUBLIC_TOKENS(SdfDataTokens, SDF_API, SDF_DATA_TOKENS);
 
+/// \class SdfAbstractDataMemoryUsage
+///
+/// Breakdown of the memory held by an SdfAbstractData object, as reported
+/// by SdfAbstractData::GetMemoryUsage().  All sizes are in bytes and are
+/// estimates computed from the data's own containers, without requiring
+/// TfMallocTag.
+///
+struct SdfAbstractDataMemoryUsage
+{
+    /// Memory used by the table of specs, keyed by path.
+    size_t specTableBytes = 0;
+
+    /// Memory used by the per-spec vectors of field names and values, not
+    /// including memory owned by the values themselves.
+    size_t fieldBytes = 0;
+
+    /// Memory owned by field values other than time samples, keyed by the
+    /// name of the value's type.
+    std::map<std::string, size_t> valueBytesByType;
+
+    /// Memory owned by time sample times and values.
+    size_t timeSampleBytes = 0;
+
+    /// Size of the file content mapped into memory and read without copying.
+    /// These pages are backed by the file and may not all be resident.
+    /// Elements of arrays that refer directly into this mapping are counted
+    /// here and not in valueBytesByType or timeSampleBytes.
+    size_t mappedBytes = 0;
+
+    /// Memory used by file format specific structural tables, such as the
+    /// path, token and field tables of a usdc file.
+    size_t structuralBytes = 0;
+
+    /// Return the sum of the entries in valueBytesByType.
+    SDF_API
+    size_t GetValueBytes() const;
+
+    /// Return the total heap memory, which is every category except
+    /// mappedBytes.
+    SDF_API
+    size_t GetTotalBytes() const;
+
+    /// Add the sizes in \p other to the sizes in this object.
+    SDF_API
+    SdfAbstractDataMemoryUsage &operator+=(
+        const SdfAbstractDataMemoryUsage &other);
+};
+
 
 /// \class SdfAbstractData
 ///
@@ -255,6 +306,82 @@ public:
 
     /// @}
 
+    /// \name Composition dependency API
+    /// @{
+
+    /// Return the asset paths of all layers referred to by reference,
+    /// payload and sublayer fields in this data object.
+    ///
+    /// This includes the added or explicit items of the references and
+    /// payload list ops on every prim and variant spec, as well as the
+    /// sublayers of the pseudo-root.
+    ///
+    /// The default implementation visits every spec to find prim and variant
+    /// specs, then reads their composition fields in parallel. Derived
+    /// classes may override this to answer the query directly from their
+    /// internal representation.
+    SDF_API
+    virtual std::set<std::string> GetCompositionAssetDependencies() const;
+
+    /// @}
+
+    /// \name Memory accounting API
+    /// @{
+
+    /// Return an estimate of the memory held by this data object.
+    ///
+    /// The default implementation visits every spec and estimates the
+    /// memory of each field value returned by Get().  Derived classes should
+    /// override this to account for their own storage, including memory
+    /// mapped file content and structural tables.
+    SDF_API
+    virtual SdfAbstractDataMemoryUsage GetMemoryUsage() const;
+
+    /// @}
+
+    /// \name Paging API
+    /// @{
+
+    /// Release the in-memory representation of this data, to be reloaded
+    /// from its backing store on the next access.  Return true if the data
+    /// was paged out, false if it does not support paging or cannot
+    /// currently be paged out.
+    ///
+    /// This must not be called concurrently with any other access to this
+    /// data object.  The default implementation returns false.
+    SDF_API
+    virtual bool PageOut();
+
+    /// Return true if this data is currently paged out.  The default
+    /// implementation returns false.
+    SDF_API
+    virtual bool IsPagedOut() const;
+
+    /// Return the access epoch of the most recent access to this data, or
+    /// zero if this data does not track accesses.  Data that supports
+    /// paging records GetAccessEpoch() on its first access after each call
+    /// to ResetAccessTracking(), so that callers can page out the least
+    /// recently used data first without every access writing the epoch.
+    SDF_API
+    virtual size_t GetLastAccessEpoch() const;
+
+    /// Make the next access to this data record the then current access
+    /// epoch.  Call this on all data after AdvanceAccessEpoch().  The
+    /// default implementation does nothing.
+    SDF_API
+    virtual void ResetAccessTracking() const;
+
+    /// Return the current access epoch.
+    SDF_API
+    static size_t GetAccessEpoch();
+
+    /// Start a new access epoch and return it.  Accesses after this call
+    /// rank as more recent than all accesses before it.
+    SDF_API
+    static size_t AdvanceAccessEpoch();
+
+    /// @}
+
 
     /// \name Dict key access API
     /// @{
@@ -395,6 +522,25 @@ protected:
     /// \sa SdfAbstractDataSpecVisitor
     SDF_API
     virtual void _VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const = 0;
+
+    /// Insert the asset paths of the composition dependencies held in
+    /// \p value, the value of the field \p fieldName, into \p assetPaths.
+    /// Fields other than references, payload and sublayers are ignored.
+    SDF_API
+    static void _AddCompositionAssetDependencies(
+        const TfToken &fieldName, const VtValue &value,
+        std::set<std::string> *assetPaths);
+
+    /// Return an estimate of the heap memory owned by \p value, not
+    /// including the VtValue object itself.
+    SDF_API
+    static size_t _GetValueHeapBytes(const VtValue &value);
+
+    /// Add the heap memory owned by \p value to \p usage, either under the
+    /// value's type name or, for an SdfTimeSampleMap, to the time samples.
+    SDF_API
+    static void _AddValueMemoryUsage(
+        const VtValue &value, SdfAbstractDataMemoryUsage *usage);
 };
 
 template <class T>
@@ -16,10 +16,29 @@ SdfChangeBlock::SdfChangeBlock()
 {
 }
 
+SdfChangeBlock::SdfChangeBlock(const SdfChangeList::Options &options)
+    : _key(Sdf_ChangeManager::Get()._OpenChangeBlock(this, &options))
+{
+}
+
+SdfChangeBlock::SdfChangeBlock(SdfSharedChangeBlock &shared)
+    : _key(Sdf_ChangeManager::Get()._OpenChangeBlock(this, nullptr, &shared))
+{
+}
+
 void
 SdfChangeBlock::_CloseChangeBlock(void const *key) const
 {
     Sdf_ChangeManager::Get()._CloseChangeBlock(this, key);
 }
 
+SdfSharedChangeBlock::SdfSharedChangeBlock()
+{
+}
+
+SdfSharedChangeBlock::~SdfSharedChangeBlock()
+{
+    Sdf_ChangeManager::Get()._CloseSharedChangeBlock(this);
+}
+
 SDF_NAMESPACE_CLOSE_SCOPE
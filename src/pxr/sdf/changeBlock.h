@@ -10,9 +10,14 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/api.h"
+#include "pxr/sdf/changeList.h"
+
+#include <mutex>
 
 SDF_NAMESPACE_OPEN_SCOPE
 
+class SdfSharedChangeBlock;
+
 /// \class SdfChangeBlock
 ///
 /// <b>DANGER DANGER DANGER</b>
@@ -58,6 +63,21 @@ class SdfChangeBlock {
 public:
     SDF_API
     SdfChangeBlock();
+
+    /// Open a change block whose change lists record changes according to
+    /// \p options, for example to compact the changes from a bulk edit.
+    /// The options only take effect if this is the outermost change block
+    /// on the calling thread.
+    SDF_API
+    explicit SdfChangeBlock(const SdfChangeList::Options &options);
+
+    /// Open a change block whose changes are handed to \p shared instead of
+    /// being sent when it closes.  This only takes effect if this is the
+    /// outermost change block on the calling thread; otherwise the changes
+    /// are sent with the enclosing block's round as usual.
+    SDF_API
+    explicit SdfChangeBlock(SdfSharedChangeBlock &shared);
+
     ~SdfChangeBlock() {
         if (_key) {
             _CloseChangeBlock(_key);
@@ -70,6 +90,55 @@ private:
     void const *_key;
 };
 
+/// \class SdfSharedChangeBlock
+///
+/// Collects the changes made in a parallel region into a single round of
+/// change processing.
+///
+/// Change blocks are per-thread, so authoring from several worker threads
+/// normally sends one round of notices per outermost change block.  Instead,
+/// workers can open an SdfChangeBlock on a shared block:
+///
+/// \code
+/// SdfSharedChangeBlock shared;
+/// WorkParallelForEach(prims.begin(), prims.end(), [&](SdfPath const &p) {
+///     SdfChangeBlock block(shared);
+///     ...
+/// });
+/// \endcode
+///
+/// When each worker's change block closes, its change lists are merged into
+/// the shared block.  When the shared block is destroyed, the merged changes
+/// are sent in one round from the destroying thread, or with the round of its
+/// open change block if there is one.  The shared block must outlive the
+/// change blocks opened on it.
+///
+/// Changes to the same path from different threads are merged in the order
+/// their change blocks closed.  Their flags are combined by union, rather
+/// than reconciled as changes made in sequence on one thread are, so for
+/// example a prim added on one thread and removed on another is reported as
+/// both added and removed.
+///
+/// The same caveats as for SdfChangeBlock apply to every thread that
+/// contributes to the shared block.
+///
+class SdfSharedChangeBlock {
+    SdfSharedChangeBlock(const SdfSharedChangeBlock&) = delete;
+    SdfSharedChangeBlock& operator=(const SdfSharedChangeBlock&) = delete;
+public:
+    SDF_API
+    SdfSharedChangeBlock();
+
+    SDF_API
+    ~SdfSharedChangeBlock();
+
+private:
+    friend class Sdf_ChangeManager;
+
+    std::mutex _mutex;
+    SdfLayerChangeListVec _changes;
+};
+
 SDF_NAMESPACE_CLOSE_SCOPE
 
 #endif // PXR_SDF_CHANGE_BLOCK_H
@@ -10,6 +10,8 @@
 #include <pxr/tf/enum.h>
 #include <pxr/tf/type.h>
 
+#include <algorithm>
+#include <iterator>
 #include <ostream>
 
 SDF_NAMESPACE_OPEN_SCOPE
@@ -98,6 +100,8 @@ std::ostream& operator<<(std::ostream &os, const SdfChangeList &cl)
             os << "   didRemovePropertyWithOnlyRequiredFields\n";
         if (entry.flags.didRemoveProperty)
             os << "   didRemoveProperty\n";
+        if (entry.flags.didChangeSubtree)
+            os << "   didChangeSubtree\n";
     }
     return os;
 }
@@ -107,6 +111,10 @@ SdfChangeList::SdfChangeList(SdfChangeList const &o)
     : _entries(o._entries)
     , _entriesAccel(o._entriesAccel ?
                     new _AccelTable(*o._entriesAccel) : nullptr)
+    , _options(o._options)
+    , _prefixCounts(o._prefixCounts ?
+                    new _PrefixCountTable(*o._prefixCounts) : nullptr)
+    , _numAbsorbedEntries(o._numAbsorbedEntries)
 {
 }
 
@@ -118,10 +126,25 @@ SdfChangeList::operator=(SdfChangeList const &o)
         _entriesAccel.reset(
             o._entriesAccel ?
             new _AccelTable(*o._entriesAccel) : nullptr);
+        _options = o._options;
+        _prefixCounts.reset(
+            o._prefixCounts ?
+            new _PrefixCountTable(*o._prefixCounts) : nullptr);
+        _numAbsorbedEntries = o._numAbsorbedEntries;
     }
     return *this;
 }
 
+void
+SdfChangeList::SetOptions(const Options &options)
+{
+    _options = options;
+    if (!_options.compactionThreshold) {
+        _RemoveAbsorbedEntries();
+        _prefixCounts.reset();
+    }
+}
+
 SdfChangeList::Entry const &
 SdfChangeList::GetEntry( const SdfPath & path ) const
 {
@@ -162,6 +185,20 @@ SdfChangeList::_MoveEntry(SdfPath const &oldPath, SdfPath const &newPath)
     // replaying would create /B then /C and the prim order would be
     // [B, C].  The prim order should be [C, B] since we created A
     // first.
+    // The entry for a collapsed prefix stands in for every change beneath
+    // it, so its collapse marker has to move with it.  Drop the entries it
+    // absorbed first, since they would no longer be beneath a marker.
+    bool movesCollapsedPrefix = false;
+    if (_prefixCounts) {
+        auto marker = _prefixCounts->find(oldPath);
+        if (marker != _prefixCounts->end() &&
+            marker->second == _CollapsedPrefix) {
+            movesCollapsedPrefix = true;
+            _RemoveAbsorbedEntries();
+            _prefixCounts->erase(oldPath);
+        }
+    }
+
     Entry tmp;
     auto constIter = FindEntry(oldPath);
     if (constIter != _entries.end()) {
@@ -186,7 +223,17 @@ SdfChangeList::_MoveEntry(SdfPath const &oldPath, SdfPath const &newPath)
     // populates the new entry with the old entry (if one existed) or it clears
     // out the new entry.
     Entry &newEntry = _GetEntry(newPath);
+    if (&newEntry == _absorbedEntry.get()) {
+        // newPath is beneath a collapsed prefix, whose entry covers it, but
+        // the old entry is gone, so record that something left oldPath.
+        _GetEntry(oldPath.GetParentPath()).flags.didChangeSubtree = true;
+        return newEntry;
+    }
     newEntry = std::move(tmp);
+    if (movesCollapsedPrefix) {
+        newEntry.flags.didChangeSubtree = true;
+        (*_prefixCounts)[newPath] = _CollapsedPrefix;
+    }
 
     // Indicate that a rename occurred.
     newEntry.flags.didRename = true;
@@ -253,6 +300,16 @@ SdfChangeList::FindEntry(const SdfPath & path) const
 SdfChangeList::Entry &
 SdfChangeList::_AddNewEntry(SdfPath const &path)
 {
+    if (_options.compactionThreshold && !_CountEntryForCompaction(path)) {
+        if (_absorbedEntry) {
+            *_absorbedEntry = Entry();
+        }
+        else {
+            _absorbedEntry.reset(new Entry);
+        }
+        return *_absorbedEntry;
+    }
+
     _entries.emplace_back(std::piecewise_construct,
                           std::tie(path), std::tuple<>());
     if (_entriesAccel) {
@@ -280,6 +337,161 @@ SdfChangeList::_RebuildAccel()
     }
 }
 
+bool
+SdfChangeList::_CountEntryForCompaction(SdfPath const &path)
+{
+    if (!_prefixCounts) {
+        _prefixCounts.reset(new _PrefixCountTable);
+    }
+
+    // Changes beneath a collapsed prefix are absorbed by its entry.
+    if (_IsAbsorbed(path)) {
+        return false;
+    }
+
+    // Count the entry against every prefix, and find the deepest prefix that
+    // has reached the threshold.
+    const SdfPath &root = SdfPath::AbsoluteRootPath();
+    SdfPath collapsePrefix;
+    for (SdfPath prefix = path.GetParentPath();
+         !prefix.IsEmpty() && prefix != root;
+         prefix = prefix.GetParentPath()) {
+        size_t &count = (*_prefixCounts)[prefix];
+        if (++count >= _options.compactionThreshold &&
+            collapsePrefix.IsEmpty()) {
+            collapsePrefix = prefix;
+        }
+    }
+
+    if (collapsePrefix.IsEmpty()) {
+        return true;
+    }
+
+    // path is beneath the collapsed prefix, so it is absorbed as well.
+    _CollapseEntriesUnder(collapsePrefix);
+    return false;
+}
+
+void
+SdfChangeList::_CollapseEntriesUnder(SdfPath const &prefix)
+{
+    // The collapsed entries no longer count against the prefix's ancestors,
+    // so that collapsing does not cascade up to them.
+    size_t &prefixCount = (*_prefixCounts)[prefix];
+    const size_t numCollapsed = prefixCount;
+    prefixCount = _CollapsedPrefix;
+    const SdfPath &root = SdfPath::AbsoluteRootPath();
+    for (SdfPath ancestor = prefix.GetParentPath();
+         !ancestor.IsEmpty() && ancestor != root;
+         ancestor = ancestor.GetParentPath()) {
+        (*_prefixCounts)[ancestor] -= numCollapsed;
+    }
+
+    // Removing the entries beneath the prefix requires a pass over the whole
+    // list, so defer it until enough entries have been absorbed to pay for
+    // it.  Until then the stale entries may still receive changes, which are
+    // discarded along with them.
+    // The count includes the path being added, which is absorbed without
+    // ever being an entry.
+    _numAbsorbedEntries += numCollapsed - 1;
+    if (_numAbsorbedEntries * 2 >= _entries.size()) {
+        _RemoveAbsorbedEntries();
+    }
+
+    // Note that recording the entry for prefix may in turn collapse one of
+    // its ancestors, in which case this flags the absorbed entry instead.
+    _GetEntry(prefix).flags.didChangeSubtree = true;
+}
+
+bool
+SdfChangeList::_IsAbsorbed(SdfPath const &path) const
+{
+    if (!_prefixCounts) {
+        return false;
+    }
+
+    const SdfPath &root = SdfPath::AbsoluteRootPath();
+    for (SdfPath prefix = path.GetParentPath();
+         !prefix.IsEmpty() && prefix != root;
+         prefix = prefix.GetParentPath()) {
+        const auto it = _prefixCounts->find(prefix);
+        if (it != _prefixCounts->end() && it->second == _CollapsedPrefix) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+SdfChangeList::_RemoveAbsorbedEntries()
+{
+    if (!_numAbsorbedEntries) {
+        return;
+    }
+
+    _entries.erase(
+        std::remove_if(_entries.begin(), _entries.end(),
+                       [this](EntryList::value_type const &e) {
+                           return _IsAbsorbed(e.first);
+                       }),
+        _entries.end());
+    _RebuildAccel();
+    _numAbsorbedEntries = 0;
+}
+
+void
+SdfChangeList::_Merge(SdfChangeList &&other)
+{
+    other._RemoveAbsorbedEntries();
+
+    for (auto &pathAndEntry : other._entries) {
+        Entry &otherEntry = pathAndEntry.second;
+        auto iter = FindEntry(pathAndEntry.first);
+        if (iter == _entries.end()) {
+            _AddNewEntry(pathAndEntry.first) = std::move(otherEntry);
+            continue;
+        }
+
+        Entry &entry = _MakeNonConstIterator(iter)->second;
+
+        // Keep the first old value and the last new value for each key.
+        for (auto &keyAndChange : otherEntry.infoChanged) {
+            auto infoIter = std::find_if(
+                entry.infoChanged.begin(), entry.infoChanged.end(),
+                [&keyAndChange](Entry::InfoChangeVec::value_type const &c) {
+                    return c.first == keyAndChange.first;
+                });
+            if (infoIter == entry.infoChanged.end()) {
+                entry.infoChanged.push_back(std::move(keyAndChange));
+            }
+            else {
+                infoIter->second.second =
+                    std::move(keyAndChange.second.second);
+            }
+        }
+
+        entry.subLayerChanges.insert(
+            entry.subLayerChanges.end(),
+            std::make_move_iterator(otherEntry.subLayerChanges.begin()),
+            std::make_move_iterator(otherEntry.subLayerChanges.end()));
+
+        if (entry.oldPath.IsEmpty()) {
+            entry.oldPath = otherEntry.oldPath;
+        }
+        if (entry.oldIdentifier.empty()) {
+            entry.oldIdentifier = std::move(otherEntry.oldIdentifier);
+        }
+
+        // Flags are not reconciled the way the Did* methods do for changes
+        // made in sequence, for example an add in one list and a remove in
+        // the other are both reported.  Their union is conservative.
+        entry.flags |= otherEntry.flags;
+    }
+
+    other._entries.clear();
+    other._RebuildAccel();
+}
+
 void
 SdfChangeList::_EraseEntry(SdfPath const &path)
 {
@@ -339,6 +551,13 @@ SdfChangeList::DidChangeInfo(const SdfPath & path, const TfToken & key,
     Entry &entry = _GetEntry(path);
 
     auto iter = entry.FindInfoChange(key);
+    if (!_options.captureInfoValues) {
+        if (iter == entry.infoChanged.end()) {
+            entry.infoChanged.emplace_back(key, Entry::InfoChange());
+        }
+        return;
+    }
+
     if (iter == entry.infoChanged.end()) {
         entry.infoChanged.emplace_back(
             key, std::make_pair(std::move(oldVal), newVal));
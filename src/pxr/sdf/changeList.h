@@ -49,6 +49,43 @@ public:
         SubLayerOffset
     };
 
+    /// \struct Options
+    ///
+    /// Controls how much detail a change list records.  The defaults record
+    /// every change individually, with old and new values.  Bulk edits can
+    /// trade detail for memory and notice-processing time by using a compact
+    /// configuration, typically via SdfChangeBlock::SdfChangeBlock(const
+    /// SdfChangeList::Options &).
+    ///
+    struct Options {
+        /// If non-zero, once this many entries have been recorded beneath a
+        /// common namespace prefix, they are collapsed into the entry for
+        /// that prefix, which is flagged with \c didChangeSubtree.  Further
+        /// changes beneath the prefix are then absorbed by that entry.  Of
+        /// all prefixes that reach the threshold, the deepest is collapsed.
+        size_t compactionThreshold = 0;
+
+        /// If false, info changes only record the changed keys; the old and
+        /// new values in Entry::infoChanged are left empty.  When set on
+        /// the outermost SdfChangeBlock, layers also skip fetching and
+        /// copying field values for notification, so bulk edits do not keep
+        /// the replaced values alive until notices are sent.  Listeners
+        /// read current values from the layer; old values are not
+        /// available.
+        ///
+        /// This is chosen by the code making the edits, not by listeners:
+        /// values must be copied when a change is recorded, before it is
+        /// known which listeners will receive the notice.
+        bool captureInfoValues = true;
+    };
+
+    /// Set the options for changes recorded from now on.  Entries that were
+    /// already recorded are not affected.
+    SDF_API void SetOptions(const Options &options);
+
+    /// Return the options for changes recorded by this change list.
+    const Options &GetOptions() const { return _options; }
+
     SDF_API void DidReplaceLayerContent();
     SDF_API void DidReloadLayerContent();
     SDF_API void DidChangeLayerResolvedPath();
@@ -178,6 +215,45 @@ public:
             bool didAddProperty:1;
             bool didRemovePropertyWithOnlyRequiredFields:1;
             bool didRemoveProperty:1;
+
+            // Compacted change lists: arbitrary changes were made beneath
+            // this path and were not recorded individually.
+            bool didChangeSubtree:1;
+
+            // Set every flag that is set in \p other.
+            _Flags &operator|=(_Flags const &other) {
+                didChangeIdentifier |= other.didChangeIdentifier;
+                didChangeResolvedPath |= other.didChangeResolvedPath;
+                didReplaceContent |= other.didReplaceContent;
+                didReloadContent |= other.didReloadContent;
+                didReorderChildren |= other.didReorderChildren;
+                didReorderProperties |= other.didReorderProperties;
+                didRename |= other.didRename;
+                didChangePrimVariantSets |= other.didChangePrimVariantSets;
+                didChangePrimInheritPaths |= other.didChangePrimInheritPaths;
+                didChangePrimSpecializes |= other.didChangePrimSpecializes;
+                didChangePrimReferences |= other.didChangePrimReferences;
+                didChangeAttributeTimeSamples |=
+                    other.didChangeAttributeTimeSamples;
+                didChangeAttributeConnection |=
+                    other.didChangeAttributeConnection;
+                didChangeRelationshipTargets |=
+                    other.didChangeRelationshipTargets;
+                didAddTarget |= other.didAddTarget;
+                didRemoveTarget |= other.didRemoveTarget;
+                didAddInertPrim |= other.didAddInertPrim;
+                didAddNonInertPrim |= other.didAddNonInertPrim;
+                didRemoveInertPrim |= other.didRemoveInertPrim;
+                didRemoveNonInertPrim |= other.didRemoveNonInertPrim;
+                didAddPropertyWithOnlyRequiredFields |=
+                    other.didAddPropertyWithOnlyRequiredFields;
+                didAddProperty |= other.didAddProperty;
+                didRemovePropertyWithOnlyRequiredFields |=
+                    other.didRemovePropertyWithOnlyRequiredFields;
+                didRemoveProperty |= other.didRemoveProperty;
+                didChangeSubtree |= other.didChangeSubtree;
+                return *this;
+            }
         };
 
         _Flags flags;
@@ -220,6 +296,9 @@ private:
     friend void swap(SdfChangeList &a, SdfChangeList &b) {
         a._entries.swap(b._entries);
         a._entriesAccel.swap(b._entriesAccel);
+        std::swap(a._options, b._options);
+        a._prefixCounts.swap(b._prefixCounts);
+        std::swap(a._numAbsorbedEntries, b._numAbsorbedEntries);
     }
     
     Entry &_GetEntry(SdfPath const &);
@@ -237,10 +316,49 @@ private:
 
     void _RebuildAccel();
 
+    // Count a new entry at \p path against the prefixes above it, collapsing
+    // the deepest prefix that reaches the compaction threshold.  Return false
+    // if \p path is beneath a collapsed prefix, in which case no entry should
+    // be recorded for it.
+    bool _CountEntryForCompaction(SdfPath const &path);
+
+    // Collapse all entries beneath \p prefix and flag the entry for
+    // \p prefix with didChangeSubtree.
+    void _CollapseEntriesUnder(SdfPath const &prefix);
+
+    // Return true if \p path is beneath a collapsed prefix.
+    bool _IsAbsorbed(SdfPath const &path) const;
+
+    // Remove entries beneath collapsed prefixes.  Sdf_ChangeManager calls
+    // this before handing a compacted change list to clients.
+    void _RemoveAbsorbedEntries();
+
+    // Merge the changes recorded in \p other, which were made after the
+    // changes in this list, into this list.
+    void _Merge(SdfChangeList &&other);
+    friend class Sdf_ChangeManager;
+
     EntryList _entries;
     using _AccelTable = std::unordered_map<SdfPath, size_t, SdfPath::Hash>;
     std::unique_ptr<_AccelTable> _entriesAccel;
     static constexpr size_t _AccelThreshold = 64;
+
+    Options _options;
+
+    // Number of entries recorded beneath each prefix when compacting.
+    // Collapsed prefixes are marked with _CollapsedPrefix.
+    using _PrefixCountTable =
+        std::unordered_map<SdfPath, size_t, SdfPath::Hash>;
+    std::unique_ptr<_PrefixCountTable> _prefixCounts;
+    static constexpr size_t _CollapsedPrefix = size_t(-1);
+
+    // Number of entries beneath collapsed prefixes that have not been
+    // removed from _entries yet.
+    size_t _numAbsorbedEntries = 0;
+
+    // Receives changes beneath collapsed prefixes, which are discarded.
+    // Allocated on first use, since most lists never collapse a prefix.
+    std::unique_ptr<Entry> _absorbedEntry;
 };
 
 // Stream-output operator
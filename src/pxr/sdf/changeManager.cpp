@@ -16,8 +16,12 @@
 #include <pxr/trace/trace.h>
 #include <pxr/tf/instantiateSingleton.h>
 #include <pxr/tf/stackTrace.h>
+#include <pxr/tf/envSetting.h>
+#include <pxr/work/loops.h>
+#include <pxr/work/withScopedParallelism.h>
 
 #include <atomic>
+#include <mutex>
 
 using std::string;
 using std::vector;
@@ -26,8 +30,18 @@ SDF_NAMESPACE_OPEN_SCOPE
 
 TF_INSTANTIATE_SINGLETON(Sdf_ChangeManager);
 
+TF_DEFINE_ENV_SETTING(
+    SDF_CHANGE_MANAGER_CONCURRENT_NOTICES, false,
+    "If enabled, LayersDidChangeSentPerLayerConcurrently notices are sent, "
+    "from worker threads in parallel for rounds that change many layers.  "
+    "Otherwise they are not sent.");
+
+// Rounds that change fewer layers send their concurrent notices serially.
+static constexpr size_t _MinLayersForConcurrentNotices = 8;
+
 Sdf_ChangeManager::_Data::_Data()
     : outermostBlock(nullptr)
+    , sharedBlock(nullptr)
 {
 }
 
@@ -73,11 +87,15 @@ Sdf_ChangeManager::_SendNoticesForChangeList( const SdfLayerHandle & layer,
 }
 
 void const *
-Sdf_ChangeManager::_OpenChangeBlock(SdfChangeBlock const *block)
+Sdf_ChangeManager::_OpenChangeBlock(SdfChangeBlock const *block,
+                                    SdfChangeList::Options const *options,
+                                    SdfSharedChangeBlock *shared)
 {
     _Data &data = _data.local();
     if (!data.outermostBlock) {
         data.outermostBlock = block;
+        data.listOptions = options ? *options : SdfChangeList::Options();
+        data.sharedBlock = shared;
         return static_cast<void const *>(&data);
     }
     return nullptr;
@@ -95,11 +113,62 @@ Sdf_ChangeManager::_CloseChangeBlock(
     // block is still open.
     _ProcessRemoveIfInert(&data);
 
-    // Send notices with no change block open.
     data.outermostBlock = nullptr;
+    data.listOptions = SdfChangeList::Options();
+
+    if (SdfSharedChangeBlock *shared = data.sharedBlock) {
+        // Hand the changes to the shared block.  Leave the TLS changes
+        // vector empty so this thread can queue up more changes.
+        data.sharedBlock = nullptr;
+        SdfLayerChangeListVec changes = std::move(data.changes);
+        data.changes.clear();
+
+        std::lock_guard<std::mutex> lock(shared->_mutex);
+        _MergeChanges(&shared->_changes, std::move(changes));
+        return;
+    }
+
+    // Send notices with no change block open.
     _SendNotices(&data);
 }
 
+void
+Sdf_ChangeManager::_CloseSharedChangeBlock(SdfSharedChangeBlock *shared)
+{
+    SdfLayerChangeListVec changes;
+    {
+        std::lock_guard<std::mutex> lock(shared->_mutex);
+        changes = std::move(shared->_changes);
+    }
+
+    // If a change block is open on this thread the merged changes are sent
+    // with its round, otherwise send them now.
+    _Data &data = _data.local();
+    _MergeChanges(&data.changes, std::move(changes));
+    if (!data.outermostBlock) {
+        _SendNotices(&data);
+    }
+}
+
+void
+Sdf_ChangeManager::_MergeChanges(SdfLayerChangeListVec *dst,
+                                 SdfLayerChangeListVec &&src)
+{
+    for (auto &layerAndChanges : src) {
+        auto iter = std::find_if(
+            dst->begin(), dst->end(),
+            [&layerAndChanges](SdfLayerChangeListVec::value_type const &p) {
+                return p.first == layerAndChanges.first;
+            });
+        if (iter == dst->end()) {
+            dst->push_back(std::move(layerAndChanges));
+        }
+        else {
+            iter->second._Merge(std::move(layerAndChanges.second));
+        }
+    }
+}
+
 void
 Sdf_ChangeManager::RemoveSpecIfInert(const SdfSpec& spec)
 {
@@ -140,6 +209,18 @@ _InitChangeSerialNumber() {
     return value;
 }
 
+static std::atomic<size_t> &
+_GetChangeSerialNumber() {
+    static std::atomic<size_t> &value = _InitChangeSerialNumber();
+    return value;
+}
+
+size_t
+Sdf_ChangeManager::GetNextSerialNumber() const
+{
+    return _GetChangeSerialNumber().load();
+}
+
 SdfChangeList
 Sdf_ChangeManager::ExtractLocalChanges(
     const SdfLayerHandle &layer)
@@ -154,6 +235,7 @@ Sdf_ChangeManager::ExtractLocalChanges(
 
     if (result != layerChanges.end()) {
         changeList = std::move((*result).second);
+        changeList._RemoveAbsorbedEntries();
         layerChanges.erase(result);
     }
 
@@ -183,6 +265,10 @@ Sdf_ChangeManager::_SendNotices(_Data *data)
     if (changes.empty())
         return;
 
+    for (auto &lc: changes) {
+        lc.second._RemoveAbsorbedEntries();
+    }
+
     for (auto const &lc: changes) {
         // Send layer-specific notices.
         _SendNoticesForChangeList(lc.first, lc.second);
@@ -194,8 +280,13 @@ Sdf_ChangeManager::_SendNotices(_Data *data)
     }
 
     // Obtain a serial number for this round of change processing.
-    static std::atomic<size_t> &changeSerialNumber = _InitChangeSerialNumber();
-    size_t serialNumber = changeSerialNumber.fetch_add(1);
+    size_t serialNumber = _GetChangeSerialNumber().fetch_add(1);
+
+    // Record the round in the journals of layers that keep one, so that
+    // listeners can already find it there.
+    for (auto const &lc: changes) {
+        lc.first->_RecordChangesInJournal(serialNumber, lc.second);
+    }
 
     // Send global notice.
     SdfNotice::LayersDidChange(changes, serialNumber).Send();
@@ -208,6 +299,34 @@ Sdf_ChangeManager::_SendNotices(_Data *data)
         n.Send(lc.first);
     }
 
+    // Deliver the same notice to listeners that registered for it as
+    // thread-safe, if enabled.  TfNotice cannot tell whether anyone listens,
+    // and sending to every layer costs a registry lookup each, so this is
+    // opt-in.  Only fan out to worker threads when there are enough layers
+    // to pay for the dispatch; otherwise send serially.  Isolate the
+    // parallel sends so that this thread does not pick up unrelated tasks
+    // while listeners run, which could deadlock with locks the sender holds.
+    if (TfGetEnvSetting(SDF_CHANGE_MANAGER_CONCURRENT_NOTICES)) {
+        SdfNotice::LayersDidChangeSentPerLayerConcurrently
+            concurrentNotice(changes, serialNumber);
+        if (changes.size() < _MinLayersForConcurrentNotices) {
+            for (auto const &lc: changes) {
+                concurrentNotice.Send(lc.first);
+            }
+        }
+        else {
+            WorkWithScopedParallelism([&changes, &concurrentNotice]() {
+                WorkParallelForN(
+                    changes.size(),
+                    [&changes, &concurrentNotice](size_t begin, size_t end) {
+                        for (size_t i = begin; i != end; ++i) {
+                            concurrentNotice.Send(changes[i].first);
+                        }
+                    }, /*grainSize=*/1);
+            });
+        }
+    }
+
     // If no new changes have been queued in the meantime then move the changes
     // vector back and clear it.  This is a performance optimization: it lets us
     // reuse the existing capacity in the changes vector, so we can potentially
@@ -221,6 +340,7 @@ Sdf_ChangeManager::_SendNotices(_Data *data)
 void
 Sdf_ChangeManager::DidReplaceLayerContent(const SdfLayerHandle &layer)
 {
+    layer->_rootPrimTextCache.reset();
     if (!layer->_ShouldNotify())
         return;
     _GetListFor(_data.local().changes, layer).DidReplaceLayerContent();
@@ -229,6 +349,7 @@ Sdf_ChangeManager::DidReplaceLayerContent(const SdfLayerHandle &layer)
 void
 Sdf_ChangeManager::DidReloadLayerContent(const SdfLayerHandle &layer)
 {
+    layer->_rootPrimTextCache.reset();
     if (!layer->_ShouldNotify())
         return;
     _GetListFor(_data.local().changes, layer).DidReloadLayerContent();
@@ -252,6 +373,24 @@ Sdf_ChangeManager::DidChangeLayerResolvedPath(const SdfLayerHandle &layer)
     _GetListFor(_data.local().changes, layer).DidChangeLayerResolvedPath();
 }
 
+bool
+Sdf_ChangeManager::NeedsFieldValues(const TfToken &field)
+{
+    if (_data.local().listOptions.captureInfoValues) {
+        return true;
+    }
+
+    // The changes recorded for these fields are derived from their values.
+    auto FieldKeys = SdfFieldKeys.Get();
+    auto ChildrenKeys = SdfChildrenKeys.Get();
+    return field == ChildrenKeys->PrimChildren ||
+        field == ChildrenKeys->PropertyChildren ||
+        field == FieldKeys->SubLayers ||
+        field == FieldKeys->SubLayerOffsets ||
+        field == FieldKeys->TimeCodesPerSecond ||
+        field == FieldKeys->FramesPerSecond;
+}
+
 static bool
 _IsOrderChangeOnly(const VtValue & oldVal, const VtValue & newVal )
 {
@@ -280,6 +419,7 @@ Sdf_ChangeManager::DidChangeField(
     const SdfPath & path, const TfToken &field,
     VtValue && oldVal, const VtValue & newVal )
 {
+    layer->_InvalidateRootPrimText(path);
     if (!layer->_ShouldNotify())
         return;
 
@@ -495,6 +635,7 @@ void
 Sdf_ChangeManager::DidChangeAttributeTimeSamples(const SdfLayerHandle &layer,
                                                  const SdfPath &attrPath)
 {
+    layer->_InvalidateRootPrimText(attrPath);
     _GetListFor(_data.local().changes, layer)
         .DidChangeAttributeTimeSamples(attrPath);
 }
@@ -503,6 +644,8 @@ void
 Sdf_ChangeManager::DidMoveSpec(const SdfLayerHandle &layer,
                                const SdfPath & oldPath, const SdfPath & newPath)
 {
+    layer->_InvalidateRootPrimText(oldPath);
+    layer->_InvalidateRootPrimText(newPath);
     if (!layer->_ShouldNotify())
         return;
 
@@ -559,6 +702,7 @@ void
 Sdf_ChangeManager::DidAddSpec(const SdfLayerHandle &layer, const SdfPath &path,
     bool inert)
 {
+    layer->_InvalidateRootPrimText(path);
     if (!layer->_ShouldNotify())
         return;
 
@@ -590,6 +734,7 @@ void
 Sdf_ChangeManager::DidRemoveSpec(const SdfLayerHandle &layer, const SdfPath &path,
     bool inert)
 {
+    layer->_InvalidateRootPrimText(path);
     if (!layer->_ShouldNotify())
         return;
 
@@ -631,7 +776,9 @@ Sdf_ChangeManager::_GetListFor(SdfLayerChangeListVec &theList,
     }
     theList.emplace_back(std::piecewise_construct,
                          std::tie(layer), std::tuple<>());
-    return theList.back().second;
+    SdfChangeList &list = theList.back().second;
+    list.SetOptions(_data.local().listOptions);
+    return list;
 }
 
 SDF_NAMESPACE_CLOSE_SCOPE
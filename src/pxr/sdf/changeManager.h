@@ -25,6 +25,7 @@ SDF_NAMESPACE_OPEN_SCOPE
 SDF_DECLARE_HANDLES(SdfLayer);
 
 class SdfChangeBlock;
+class SdfSharedChangeBlock;
 class SdfSpec;
 
 /// \class Sdf_ChangeManager
@@ -56,6 +57,17 @@ public:
     SDF_API
     SdfChangeList ExtractLocalChanges(const SdfLayerHandle &layer);
 
+    /// Returns true if the old and new values of \p field must be passed to
+    /// DidChangeField to record a change on the calling thread.  This is
+    /// false for most fields while the outermost change block disables
+    /// SdfChangeList::Options::captureInfoValues, in which case callers may
+    /// pass empty values instead of fetching or copying them.
+    bool NeedsFieldValues(const TfToken &field);
+
+    /// Returns the serial number the next round of change processing will
+    /// be sent with.
+    size_t GetNextSerialNumber() const;
+
     // Queue notifications.
     void DidReplaceLayerContent(const SdfLayerHandle &layer);
     void DidReloadLayerContent(const SdfLayerHandle &layer);
@@ -79,12 +91,18 @@ public:
 
 private:
     friend class SdfChangeBlock;
+    friend class SdfSharedChangeBlock;
     
     struct _Data {
         _Data();
         SdfLayerChangeListVec changes;
         SdfChangeBlock const *outermostBlock;
         std::vector<SdfSpec> removeIfInert;
+        // Options for change lists created in the outermost block.
+        SdfChangeList::Options listOptions;
+        // Shared block that receives the changes when the outermost block
+        // closes, if any.
+        SdfSharedChangeBlock *sharedBlock;
     };
 
     Sdf_ChangeManager();
@@ -92,12 +110,28 @@ private:
 
     // Open a change block, and return a non-null pointer if this was the
     // outermost change block.  The caller must only call _CloseChangeBlock if
-    // _OpenChangeBlock returned a non-null pointer, and pass it back.
+    // _OpenChangeBlock returned a non-null pointer, and pass it back.  If
+    // \p options is not null and this is the outermost block, change lists
+    // created until it closes use \p options.  If \p shared is not null and
+    // this is the outermost change block, its changes are merged into
+    // \p shared when it closes instead of being sent.
     SDF_API
-    void const *_OpenChangeBlock(SdfChangeBlock const *block);
+    void const *_OpenChangeBlock(
+        SdfChangeBlock const *block,
+        SdfChangeList::Options const *options = nullptr,
+        SdfSharedChangeBlock *shared = nullptr);
     SDF_API
     void _CloseChangeBlock(SdfChangeBlock const *block, void const *openKey);
 
+    // Send the changes merged into \p shared, or queue them in the calling
+    // thread's open change block.
+    SDF_API
+    void _CloseSharedChangeBlock(SdfSharedChangeBlock *shared);
+
+    // Merge the changes in \p src, made after those in \p dst, into \p dst.
+    static void _MergeChanges(SdfLayerChangeListVec *dst,
+                              SdfLayerChangeListVec &&src);
+
     void _SendNoticesForChangeList( const SdfLayerHandle & layer,
                                     const SdfChangeList & changeList );
     void _SendNotices(_Data *data);
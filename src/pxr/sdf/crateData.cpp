@@ -9,6 +9,9 @@
 #include "pxr/sdf/crateData.h"
 
 #include "crateFile.h"
+#include <pxr/ar/asset.h>
+#include <pxr/ar/resolvedPath.h>
+#include <pxr/ar/resolver.h>
 
 #include <pxr/tf/bitUtils.h>
 #include <pxr/tf/mallocTag.h>
@@ -18,6 +21,7 @@
 #include <pxr/tf/stringUtils.h>
 #include <pxr/tf/typeInfoMap.h>
 #include <pxr/tf/pxrTslRobinMap/robin_map.h>
+#include <pxr/tf/pxrTslRobinMap/robin_set.h>
 #include <pxr/trace/trace.h>
 
 #include <pxr/work/dispatcher.h>
@@ -28,6 +32,7 @@
 #include "pxr/sdf/payload.h"
 #include "pxr/sdf/schema.h"
 
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 
@@ -139,11 +144,15 @@ public:
 
         // Now pack all the specs.
         if (CrateFile::Packer packer = _crateFile->StartPacking(fileName)) {
-            for (auto const &p: sortedPaths) {
-                auto iter = _data.find(p);
-                packer.PackSpec(
-                    p, iter->second.specType, iter->second.fields.Get());
-            }
+            _FindMany(
+                0, sortedPaths.size(),
+                [&sortedPaths](size_t i) -> SdfPath const & {
+                    return sortedPaths[i];
+                },
+                [&packer, &sortedPaths](size_t i, _HashMap::iterator iter) {
+                    packer.PackSpec(sortedPaths[i], iter->second.specType,
+                                    iter->second.fields.Get());
+                });
             if (packer.Close()) {
                 return _PopulateFromCrateFile();
             }
@@ -716,9 +725,132 @@ public:
         }
     }
 
+    inline std::set<std::string> GetCompositionAssetDependencies() const {
+        TRACE_FUNCTION();
+
+        // Specs read from the file share their field-value vectors whenever
+        // they have identical fields (the crate file's field sets), so only
+        // scan each distinct vector once.  Edited specs detach their own
+        // copies, so this always reflects the current contents.
+        pxr_tsl::robin_set<_FieldValuePairVector const *> seen;
+        vector<_FieldValuePairVector const *> fieldVectors;
+        for (auto const &p: _data) {
+            const SdfSpecType specType = p.second.specType;
+            if (specType == SdfSpecTypePrim ||
+                specType == SdfSpecTypeVariant ||
+                specType == SdfSpecTypePseudoRoot) {
+                _FieldValuePairVector const *fields = &p.second.fields.Get();
+                if (seen.insert(fields).second) {
+                    fieldVectors.push_back(fields);
+                }
+            }
+        }
+
+        tbb::enumerable_thread_specific<std::set<std::string>> assetPaths;
+        WorkParallelForN(
+            fieldVectors.size(),
+            [this, &fieldVectors, &assetPaths](size_t begin, size_t end) {
+                std::set<std::string> &local = assetPaths.local();
+                for (size_t i = begin; i != end; ++i) {
+                    for (auto const &field: *fieldVectors[i]) {
+                        // Only unpack the values of the composition fields.
+                        if (field.first == SdfFieldKeys->References ||
+                            field.first == SdfFieldKeys->Payload ||
+                            field.first == SdfFieldKeys->SubLayers) {
+                            Sdf_CrateData::_AddCompositionAssetDependencies(
+                                field.first, _DetachValue(field.second),
+                                &local);
+                        }
+                    }
+                }
+            });
+
+        std::set<std::string> result;
+        for (auto const &local: assetPaths) {
+            result.insert(local.begin(), local.end());
+        }
+        return result;
+    }
+
+    inline SdfAbstractDataMemoryUsage GetMemoryUsage() const {
+        TRACE_FUNCTION();
+
+        // As above, count each distinct field-value vector only once.
+        pxr_tsl::robin_set<_FieldValuePairVector const *> seen;
+        vector<_FieldValuePairVector const *> fieldVectors;
+        for (auto const &p: _data) {
+            _FieldValuePairVector const *fields = &p.second.fields.Get();
+            if (seen.insert(fields).second) {
+                fieldVectors.push_back(fields);
+            }
+        }
+
+        tbb::enumerable_thread_specific<SdfAbstractDataMemoryUsage> usages;
+        WorkParallelForN(
+            fieldVectors.size(),
+            [this, &fieldVectors, &usages](size_t begin, size_t end) {
+                SdfAbstractDataMemoryUsage &local = usages.local();
+                for (size_t i = begin; i != end; ++i) {
+                    _FieldValuePairVector const &fields = *fieldVectors[i];
+                    local.fieldBytes +=
+                        fields.capacity() * sizeof(_FieldValuePair);
+                    for (auto const &field: fields) {
+                        VtValue const &value = field.second;
+                        if (value.IsHolding<ValueRep>()) {
+                            // Not yet unpacked, the value is still in the
+                            // file.
+                            continue;
+                        }
+                        if (value.IsHolding<TimeSamples>()) {
+                            _AddTimeSamplesMemoryUsage(
+                                value.UncheckedGet<TimeSamples>(), &local);
+                            continue;
+                        }
+                        // Zero-copy array elements are counted as mapped
+                        // file content.
+                        if (const size_t zeroCopyBytes =
+                            _crateFile->GetZeroCopyArrayBytes(value)) {
+                            local.valueBytesByType[value.GetTypeName()] +=
+                                Sdf_CrateData::_GetValueHeapBytes(value) -
+                                zeroCopyBytes;
+                            continue;
+                        }
+                        Sdf_CrateData::_AddValueMemoryUsage(value, &local);
+                    }
+                }
+            });
+
+        SdfAbstractDataMemoryUsage result;
+        result.specTableBytes =
+            _data.bucket_count() * sizeof(_HashMap::value_type);
+        for (auto const &local: usages) {
+            result += local;
+        }
+        result.mappedBytes = _crateFile->GetMappedBytes();
+        result.structuralBytes = _crateFile->GetStructuralBytes();
+        return result;
+    }
+
     ////////////////////////////////////////////////////////////////////////
 private:
 
+    void
+    _AddTimeSamplesMemoryUsage(TimeSamples const &ts,
+                               SdfAbstractDataMemoryUsage *usage) const {
+        usage->timeSampleBytes += ts.values.capacity() * sizeof(VtValue);
+        for (VtValue const &value: ts.values) {
+            usage->timeSampleBytes +=
+                Sdf_CrateData::_GetValueHeapBytes(value) -
+                _crateFile->GetZeroCopyArrayBytes(value);
+        }
+        // Times read from the file are shared and counted with the crate
+        // file's structural tables.
+        if (ts.IsInMemory()) {
+            usage->timeSampleBytes +=
+                ts.times.Get().capacity() * sizeof(double);
+        }
+    }
+
     bool _PopulateFromCrateFile() {
 
         // Ensure we start from a clean slate.
@@ -820,18 +952,19 @@ private:
             tbb::blocked_range<size_t>(0, specs.size()),
             [this, crateFile, &liveFieldSets, &specs](
                 tbb::blocked_range<size_t> const &r) {
-                for (size_t i = r.begin(),
-                         end = r.end(); i != end; ++i) {
-                    
-                    CrateFile::Spec const &spec = specs[i];
-                    _SpecData &specData = _data.find(
-                        crateFile->GetPath(spec.pathIndex)).value();
-                    
-                    specData.specType = spec.specType;
-                    specData.fields =
-                        liveFieldSets.find(spec.fieldSetIndex)->second;
-                    
-                }
+                _FindMany(
+                    r.begin(), r.end(),
+                    [crateFile, &specs](size_t i) -> SdfPath const & {
+                        return crateFile->GetPath(specs[i].pathIndex);
+                    },
+                    [&liveFieldSets, &specs](
+                        size_t i, _HashMap::iterator iter) {
+                        CrateFile::Spec const &spec = specs[i];
+                        _SpecData &specData = iter.value();
+                        specData.specType = spec.specType;
+                        specData.fields =
+                            liveFieldSets.find(spec.fieldSetIndex)->second;
+                    });
             },
             tbb::static_partitioner());
 
@@ -961,6 +1094,36 @@ private:
         return val;
     }
 
+    // Look up the paths getPath(i) for i in [begin, end) and call
+    // fn(i, iter) with each one's iterator in _data, or _data.end() if it has
+    // no spec, in order.  Bulk passes use this rather than calling find() per
+    // path: the lookups go in small batches that hash every path first and
+    // then probe for all of them, so the probes don't wait on each other or
+    // on the hashing and their cache misses can overlap.
+    template <class GetPath, class Fn>
+    inline void _FindMany(size_t begin, size_t end,
+                          GetPath const &getPath, Fn const &fn) {
+        constexpr size_t BatchSize = 16;
+        SdfPath const *paths[BatchSize];
+        size_t hashes[BatchSize];
+        _HashMap::iterator iters[BatchSize];
+        const _HashMap::hasher hash = _data.hash_function();
+        while (begin != end) {
+            const size_t count = std::min(BatchSize, end - begin);
+            for (size_t i = 0; i != count; ++i) {
+                paths[i] = &getPath(begin + i);
+                hashes[i] = hash(*paths[i]);
+            }
+            for (size_t i = 0; i != count; ++i) {
+                iters[i] = _data.find(*paths[i], hashes[i]);
+            }
+            for (size_t i = 0; i != count; ++i) {
+                fn(begin + i, iters[i]);
+            }
+            begin += count;
+        }
+    }
+
     inline _SpecData const *
     _GetSpecData(SdfPath const &path) const {
         _SpecData const *specData = nullptr;
@@ -1087,6 +1250,14 @@ Sdf_CrateData::CanRead(string const &assetPath,
     return CrateFile::CanRead(assetPath, asset);
 }
 
+// Return the modification time of the file at the resolved \p assetPath.
+static ArTimestamp
+_GetAssetTimestamp(string const &assetPath)
+{
+    return ArGetResolver().GetModificationTimestamp(
+        assetPath, ArResolvedPath(assetPath));
+}
+
 bool
 Sdf_CrateData::Save(string const &fileName)
 {
@@ -1094,8 +1265,18 @@ Sdf_CrateData::Save(string const &fileName)
         TF_CODING_ERROR("Tried to save to empty fileName");
         return false;
     }
+    if (_ReopenFailed()) {
+        TF_RUNTIME_ERROR("Cannot save @%s@: this data failed to reopen its "
+                         "file after being paged out", fileName.c_str());
+        return false;
+    }
 
-    return _impl->Save(fileName);
+    if (!_GetImpl()->Save(fileName)) {
+        return false;
+    }
+    // The data now streams from the saved file.
+    _assetTimestamp = _GetAssetTimestamp(fileName);
+    return true;
 }
 
 bool
@@ -1105,6 +1286,11 @@ Sdf_CrateData::Export(string const &fileName)
         TF_CODING_ERROR("Tried to save to empty fileName");
         return false;
     }
+    if (_ReopenFailed()) {
+        TF_RUNTIME_ERROR("Cannot export @%s@: this data failed to reopen its "
+                         "file after being paged out", fileName.c_str());
+        return false;
+    }
 
     // To Export, we copy to a temporary data and save that, since we need this
     // CrateData object to stay associated with its existing backing store.
@@ -1121,7 +1307,18 @@ bool
 Sdf_CrateData::Open(const std::string &assetPath,
                     bool detached)
 {
-    return _impl->Open(assetPath, detached);
+    // Only remember the file's modification time if it did not change while
+    // reading, so that it identifies the bytes that were read.
+    const ArTimestamp timestamp =
+        detached ? ArTimestamp() : _GetAssetTimestamp(assetPath);
+    _assetTimestamp = ArTimestamp();
+    if (!_GetImpl()->Open(assetPath, detached)) {
+        return false;
+    }
+    if (timestamp.IsValid() && timestamp == _GetAssetTimestamp(assetPath)) {
+        _assetTimestamp = timestamp;
+    }
+    return true;
 }
 
 bool
@@ -1129,7 +1326,10 @@ Sdf_CrateData::Open(const std::string &assetPath,
                     const std::shared_ptr<ArAsset> &asset,
                     bool detached)
 {
-    return _impl->Open(assetPath, asset, detached);
+    // The asset need not be what the path resolves to, so this data cannot
+    // be reopened by path and is never paged out.
+    _assetTimestamp = ArTimestamp();
+    return _GetImpl()->Open(assetPath, asset, detached);
 }
 
 // ------------------------------------------------------------------------- //
@@ -1139,44 +1339,50 @@ Sdf_CrateData::Open(const std::string &assetPath,
 bool
 Sdf_CrateData::StreamsData() const
 {
-    return _impl->StreamsData();
+    // Only streaming data is paged out, so answer without reopening it.
+    // Data that failed to reopen still stands for its file, and reporting it
+    // as streaming makes a reload replace it rather than edit it in place.
+    if (_pagedOut.load(std::memory_order_acquire)) {
+        return true;
+    }
+    return _ReopenFailed() || _impl->StreamsData();
 }
 
 bool
 Sdf_CrateData::HasSpec(const SdfPath &path) const
 {
-    return _impl->HasSpec(path);
+    return _GetImpl()->HasSpec(path);
 }
 
 void
 Sdf_CrateData::EraseSpec(const SdfPath &path)
 {
-    _impl->EraseSpec(path);
+    _GetImpl()->EraseSpec(path);
 }
 
 void
 Sdf_CrateData::MoveSpec(const SdfPath& oldPath,
                         const SdfPath& newPath)
 {
-    return _impl->MoveSpec(oldPath, newPath);
+    return _GetImpl()->MoveSpec(oldPath, newPath);
 }
 
 SdfSpecType
 Sdf_CrateData::GetSpecType(const SdfPath &path) const
 {
-    return _impl->GetSpecType(path);
+    return _GetImpl()->GetSpecType(path);
 }
 
 void
 Sdf_CrateData::CreateSpec(const SdfPath &path, SdfSpecType specType)
 {
-    _impl->CreateSpec(path, specType);
+    _GetImpl()->CreateSpec(path, specType);
 }
 
 void
 Sdf_CrateData::_VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const
 {
-    _impl->_VisitSpecs(*this, visitor);
+    _GetImpl()->_VisitSpecs(*this, visitor);
 }
 
 bool
@@ -1184,7 +1390,7 @@ Sdf_CrateData::Has(const SdfPath& path,
                    const TfToken & field,
                    SdfAbstractDataValue* value) const
 {
-    return _impl->Has(path, field, value);
+    return _GetImpl()->Has(path, field, value);
 }
 
 bool
@@ -1192,7 +1398,7 @@ Sdf_CrateData::Has(const SdfPath& path,
                    const TfToken & field,
                    VtValue *value) const
 {
-    return _impl->Has(path, field, value);
+    return _GetImpl()->Has(path, field, value);
 }
 
 bool
@@ -1200,7 +1406,7 @@ Sdf_CrateData
 ::HasSpecAndField(const SdfPath &path, const TfToken &field,
                   SdfAbstractDataValue *value, SdfSpecType *specType) const
 {
-    return _impl->Has(path, field, value, specType);
+    return _GetImpl()->Has(path, field, value, specType);
 }
 
 bool
@@ -1208,45 +1414,166 @@ Sdf_CrateData
 ::HasSpecAndField(const SdfPath &path, const TfToken &field,
                   VtValue *value, SdfSpecType *specType) const
 {
-    return _impl->Has(path, field, value, specType);
+    return _GetImpl()->Has(path, field, value, specType);
 }
 
 VtValue
 Sdf_CrateData::Get(const SdfPath& path, const TfToken & field) const
 {
-    return _impl->Get(path, field);
+    return _GetImpl()->Get(path, field);
 }
 
 std::type_info const &
 Sdf_CrateData::GetTypeid(const SdfPath& path, const TfToken& field) const
 {
-    return _impl->GetTypeid(path, field);
+    return _GetImpl()->GetTypeid(path, field);
 }
 
 std::vector<TfToken>
 Sdf_CrateData::List(const SdfPath& path) const
 {
-    return _impl->List(path);
+    return _GetImpl()->List(path);
+}
+
+std::set<std::string>
+Sdf_CrateData::GetCompositionAssetDependencies() const
+{
+    return _GetImpl()->GetCompositionAssetDependencies();
+}
+
+SdfAbstractDataMemoryUsage
+Sdf_CrateData::GetMemoryUsage() const
+{
+    // Hold the lock so that the data cannot be reopened concurrently, and
+    // isolate the parallel work done under it so this thread cannot pick up
+    // a task that waits for the lock.
+    std::lock_guard<std::mutex> lock(_pageMutex);
+    if (_pagedOut.load(std::memory_order_relaxed)) {
+        return SdfAbstractDataMemoryUsage();
+    }
+    SdfAbstractDataMemoryUsage result;
+    WorkWithScopedParallelism([this, &result]() {
+        result = _impl->GetMemoryUsage();
+    });
+    return result;
+}
+
+bool
+Sdf_CrateData::PageOut()
+{
+    std::lock_guard<std::mutex> lock(_pageMutex);
+    if (_pagedOut.load(std::memory_order_relaxed) || _ReopenFailed() ||
+        !_impl->StreamsData() || _impl->GetAssetPath().empty() ||
+        !_assetTimestamp.IsValid()) {
+        return false;
+    }
+
+    // Only drop the data if the file is unchanged since this data was read
+    // from it, and still reads as a crate file.
+    string const &assetPath = _impl->GetAssetPath();
+    const ArTimestamp timestamp = _GetAssetTimestamp(assetPath);
+    if (!timestamp.IsValid() || timestamp != _assetTimestamp ||
+        !CrateFile::CanRead(assetPath)) {
+        return false;
+    }
+
+    _pagedOutAssetPath = assetPath;
+    _accessedImpl.store(nullptr, std::memory_order_relaxed);
+    _impl.reset();
+    _pagedOut.store(true, std::memory_order_release);
+    return true;
+}
+
+bool
+Sdf_CrateData::IsPagedOut() const
+{
+    return _pagedOut.load(std::memory_order_acquire);
+}
+
+size_t
+Sdf_CrateData::GetLastAccessEpoch() const
+{
+    return _lastAccessEpoch.load(std::memory_order_relaxed);
+}
+
+void
+Sdf_CrateData::ResetAccessTracking() const
+{
+    _accessedImpl.store(nullptr, std::memory_order_relaxed);
+}
+
+Sdf_CrateDataImpl *
+Sdf_CrateData::_GetImpl() const
+{
+    if (Sdf_CrateDataImpl *impl =
+        _accessedImpl.load(std::memory_order_acquire)) {
+        return impl;
+    }
+    return _GetImplSlow();
+}
+
+Sdf_CrateDataImpl *
+Sdf_CrateData::_GetImplSlow() const
+{
+    std::lock_guard<std::mutex> lock(_pageMutex);
+    if (_pagedOut.load(std::memory_order_relaxed)) {
+        _Rehydrate();
+    }
+    _lastAccessEpoch.store(GetAccessEpoch(), std::memory_order_relaxed);
+    _accessedImpl.store(_impl.get(), std::memory_order_release);
+    return _impl.get();
+}
+
+void
+Sdf_CrateData::_Rehydrate() const
+{
+    TRACE_FUNCTION();
+
+    // Only use the reopened file if it is still the one this data was read
+    // from.  Otherwise this clean data would silently change, or, if the
+    // file cannot be read, later edits and a save would overwrite the file
+    // with whatever survived.  Fail loudly instead, leaving empty data that
+    // refuses to be saved or exported.
+    std::unique_ptr<Sdf_CrateDataImpl> impl(
+        new Sdf_CrateDataImpl(/* detached = */ false));
+    if (!impl->Open(_pagedOutAssetPath, /* detached = */ false) ||
+        _GetAssetTimestamp(_pagedOutAssetPath) != _assetTimestamp) {
+        TF_RUNTIME_ERROR("Failed to reopen paged out usd binary asset @%s@ "
+                         "unchanged; its data is lost and it cannot be "
+                         "saved", _pagedOutAssetPath.c_str());
+        impl.reset(new Sdf_CrateDataImpl(/* detached = */ false));
+        impl->CreateSpec(SdfPath::AbsoluteRootPath(), SdfSpecTypePseudoRoot);
+        _reopenFailed.store(true, std::memory_order_relaxed);
+    }
+    _impl = std::move(impl);
+    _pagedOutAssetPath.clear();
+    _pagedOut.store(false, std::memory_order_release);
+}
+
+bool
+Sdf_CrateData::_ReopenFailed() const
+{
+    return _reopenFailed.load(std::memory_order_relaxed);
 }
 
 void
 Sdf_CrateData::Set(const SdfPath& path, const TfToken& fieldName,
                    const VtValue& value)
 {
-    return _impl->Set(path, fieldName, value);
+    return _GetImpl()->Set(path, fieldName, value);
 }
 
 void
 Sdf_CrateData::Set(const SdfPath& path, const TfToken& field,
                    const SdfAbstractDataConstValue& value)
 {
-    return _impl->Set(path, field, value);
+    return _GetImpl()->Set(path, field, value);
 }
 
 void
 Sdf_CrateData::Erase(const SdfPath& path, const TfToken & field)
 {
-    return _impl->Erase(path, field);
+    return _GetImpl()->Erase(path, field);
 }
 
 // ------------------------------------------------------------------------- //
@@ -1255,26 +1582,26 @@ Sdf_CrateData::Erase(const SdfPath& path, const TfToken & field)
 std::set<double>
 Sdf_CrateData::ListAllTimeSamples() const
 {
-    return _impl->ListAllTimeSamples();
+    return _GetImpl()->ListAllTimeSamples();
 }
 
 std::set<double>
 Sdf_CrateData::ListTimeSamplesForPath(const SdfPath& path) const
 {
-    return _impl->ListTimeSamplesForPath(path);
+    return _GetImpl()->ListTimeSamplesForPath(path);
 }
 
 bool
 Sdf_CrateData::GetBracketingTimeSamples(
     double time, double* tLower, double* tUpper) const
 {
-    return _impl->GetBracketingTimeSamples(time, tLower, tUpper);
+    return _GetImpl()->GetBracketingTimeSamples(time, tLower, tUpper);
 }
 
 size_t
 Sdf_CrateData::GetNumTimeSamplesForPath(const SdfPath& path) const
 {
-    return _impl->GetNumTimeSamplesForPath(path);
+    return _GetImpl()->GetNumTimeSamplesForPath(path);
 }
 
 bool
@@ -1282,14 +1609,14 @@ Sdf_CrateData::GetBracketingTimeSamplesForPath(
     const SdfPath& path,
     double time, double* tLower, double* tUpper) const
 {
-    return _impl->GetBracketingTimeSamplesForPath(path, time, tLower, tUpper);
+    return _GetImpl()->GetBracketingTimeSamplesForPath(path, time, tLower, tUpper);
 }
 
 bool
 Sdf_CrateData::GetPreviousTimeSampleForPath(
     const SdfPath& path, double time, double* tPrevious) const
 {
-    vector<double> const &times = _impl->_ListTimeSamplesForPath(path);
+    vector<double> const &times = _GetImpl()->_ListTimeSamplesForPath(path);
     if (times.empty() || time <= times.front()) {
         // no samples, or 
         // can't get previous sample for time before first sample.
@@ -1313,27 +1640,27 @@ bool
 Sdf_CrateData::QueryTimeSample(const SdfPath& path,
                                double time, VtValue *value) const
 {
-    return _impl->QueryTimeSample(path, time, value);
+    return _GetImpl()->QueryTimeSample(path, time, value);
 }
 
 bool
 Sdf_CrateData::QueryTimeSample(const SdfPath& path,
                                double time, SdfAbstractDataValue* value) const
 {
-    return _impl->QueryTimeSample(path, time, value);
+    return _GetImpl()->QueryTimeSample(path, time, value);
 }
 
 void
 Sdf_CrateData::SetTimeSample(const SdfPath& path,
                              double time, const VtValue &value)
 {
-    return _impl->SetTimeSample(path, time, value);
+    return _GetImpl()->SetTimeSample(path, time, value);
 }
 
 void
 Sdf_CrateData::EraseTimeSample(const SdfPath& path, double time)
 {
-    return _impl->EraseTimeSample(path, time);
+    return _GetImpl()->EraseTimeSample(path, time);
 }
 
 SDF_NAMESPACE_CLOSE_SCOPE
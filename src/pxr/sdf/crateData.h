@@ -10,12 +10,16 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/abstractData.h"
+#include <pxr/ar/timestamp.h>
 
 #include <pxr/tf/declarePtrs.h>
 #include <pxr/tf/token.h>
 #include <pxr/vt/value.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <set>
 
@@ -79,6 +83,25 @@ public:
     virtual void Erase(const SdfPath& path, 
                        const TfToken& fieldName);
     virtual std::vector<TfToken> List(const SdfPath& path) const;
+
+    virtual std::set<std::string> GetCompositionAssetDependencies() const;
+
+    virtual SdfAbstractDataMemoryUsage GetMemoryUsage() const;
+
+    /// Drop the spec table and the crate file, including its mapping, if
+    /// this data streams from a file.  The file is reopened by its resolved
+    /// path on the next access.
+    ///
+    /// Only data opened by its resolved path, from a file that is unchanged
+    /// since it was opened, is paged out, and the file is closed while paged
+    /// out.  If the file cannot be reopened unchanged, the next access
+    /// reports an error and this data becomes empty and refuses to be saved
+    /// or exported, so that it never overwrites the file.  Data opened from
+    /// an explicit ArAsset is never paged out.
+    virtual bool PageOut();
+    virtual bool IsPagedOut() const;
+    virtual size_t GetLastAccessEpoch() const;
+    virtual void ResetAccessTracking() const;
     
     /// \name Time-sample API
     /// @{
@@ -125,8 +148,34 @@ private:
     // SdfAbstractData overrides
     virtual void _VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const;
 
+    // Return the implementation.  This is one atomic load unless this data
+    // is paged out or has not been accessed since the last call to
+    // ResetAccessTracking(), in which case _GetImplSlow() reopens it and
+    // records the access epoch.
+    class Sdf_CrateDataImpl *_GetImpl() const;
+    class Sdf_CrateDataImpl *_GetImplSlow() const;
+    void _Rehydrate() const;
+    bool _ReopenFailed() const;
+
     friend class Sdf_CrateDataImpl;
-    std::unique_ptr<class Sdf_CrateDataImpl> _impl;
+    mutable std::unique_ptr<class Sdf_CrateDataImpl> _impl;
+
+    // _impl if it has been accessed since the last ResetAccessTracking(),
+    // else null.  Always null while paged out.
+    mutable std::atomic<class Sdf_CrateDataImpl *> _accessedImpl { nullptr };
+
+    // State for paging out, modified with _pageMutex held.  _impl is null
+    // while _pagedOut is set.  _reopenFailed is set if reopening paged out
+    // data failed, so it was replaced with empty data.
+    mutable std::mutex _pageMutex;
+    mutable std::atomic<bool> _pagedOut { false };
+    mutable std::atomic<size_t> _lastAccessEpoch { 0 };
+    mutable std::string _pagedOutAssetPath;
+    mutable std::atomic<bool> _reopenFailed { false };
+
+    // The modification time of the file this data was opened from, invalid
+    // if it was opened from an explicit ArAsset or has no file.
+    ArTimestamp _assetTimestamp;
 };
 
 
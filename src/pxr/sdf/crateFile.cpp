@@ -2281,6 +2281,79 @@ CrateFile::GetFileVersionToken() const
     return TfToken(Version(_boot.version).AsFullString());
 }
 
+size_t
+CrateFile::GetMappedBytes() const
+{
+    return _mmapSrc ? _mmapSrc.GetLength() : 0;
+}
+
+// Return the address and size of the elements of the VtArray<T> held in
+// \p value, or null if it holds none.  Only arrays whose elements are read
+// bitwise can refer into a file mapping.
+template <class T>
+static inline typename std::enable_if<
+    _SupportsArray<T>::value && _IsBitwiseReadWrite<T>::value,
+    std::pair<void const *, size_t>>::type
+_GetZeroCopyCandidate(VtValue const &value)
+{
+    if (!value.IsHolding<VtArray<T>>()) {
+        return { nullptr, 0 };
+    }
+    VtArray<T> const &array = value.UncheckedGet<VtArray<T>>();
+    return { array.cdata(), array.size() * sizeof(T) };
+}
+
+template <class T>
+static inline typename std::enable_if<
+    !(_SupportsArray<T>::value && _IsBitwiseReadWrite<T>::value),
+    std::pair<void const *, size_t>>::type
+_GetZeroCopyCandidate(VtValue const &)
+{
+    return { nullptr, 0 };
+}
+
+size_t
+CrateFile::GetZeroCopyArrayBytes(VtValue const &value) const
+{
+    if (!_mmapSrc || !value.IsArrayValued()) {
+        return 0;
+    }
+
+    std::pair<void const *, size_t> candidate { nullptr, 0 };
+#define xx(_unused1, _unused2, T, _unused3)                                    \
+    if (!candidate.first) {                                                    \
+        candidate = _GetZeroCopyCandidate<T>(value);                           \
+    }
+
+#include "crateDataTypes.h"
+
+#undef xx
+
+    char const *addr = static_cast<char const *>(candidate.first);
+    char const *start = _mmapSrc.GetMapStart();
+    return addr && start <= addr && addr < start + _mmapSrc.GetLength() ?
+        candidate.second : 0;
+}
+
+size_t
+CrateFile::GetStructuralBytes() const
+{
+    size_t bytes =
+        _specs.capacity() * sizeof(Spec) +
+        _fields.capacity() * sizeof(Field) +
+        _fieldSets.capacity() * sizeof(FieldIndex) +
+        _paths.capacity() * sizeof(SdfPath) +
+        _tokens.capacity() * sizeof(TfToken) +
+        _strings.capacity() * sizeof(TokenIndex);
+
+    tbb::spin_rw_mutex::scoped_lock lock(_sharedTimesMutex, /*write=*/false);
+    for (auto const &entry: _sharedTimes) {
+        bytes += sizeof(entry) + sizeof(void *) +
+            entry.second.Get().capacity() * sizeof(double);
+    }
+    return bytes;
+}
+
 CrateFile::CrateFile(Options opt)
     : _detached(opt == Options::Detached)
     , _useMmap(opt == Options::UseMmap)
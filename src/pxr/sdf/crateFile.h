@@ -657,6 +657,18 @@ public:
 
     string const &GetAssetPath() const { return _assetPath; }
 
+    // Return the length of the file content read via mmap, or zero if this
+    // file's content is not memory mapped.
+    size_t GetMappedBytes() const;
+
+    // Return the size of the elements of the array held in \p value if they
+    // are a zero-copy view into this file's mapping, else zero.
+    size_t GetZeroCopyArrayBytes(VtValue const &value) const;
+
+    // Return the memory used by the structural tables: specs, fields, field
+    // sets, paths, tokens, strings and the deduplicated time sample times.
+    size_t GetStructuralBytes() const;
+
     inline Field const &
     GetField(FieldIndex i) const {
 #ifdef PXR_PREFER_SAFETY_OVER_SPEED
@@ -8,8 +8,11 @@
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/data.h"
 #include <pxr/trace/trace.h>
+#include <pxr/work/loops.h>
 #include <pxr/work/utils.h>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include <iostream>
 
 SDF_NAMESPACE_OPEN_SCOPE
@@ -94,6 +97,82 @@ SdfData::_VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const
     }
 }
 
+std::set<std::string>
+SdfData::GetCompositionAssetDependencies() const
+{
+    TRACE_FUNCTION();
+
+    // Gather the specs that may hold composition fields in a single pass over
+    // the table, then scan their fields in parallel without any further
+    // lookups or value copies.
+    std::vector<const _SpecData *> specs;
+    for (const auto &entry : _data) {
+        const SdfSpecType specType = entry.second.specType;
+        if (specType == SdfSpecTypePrim ||
+            specType == SdfSpecTypeVariant ||
+            specType == SdfSpecTypePseudoRoot) {
+            specs.push_back(&entry.second);
+        }
+    }
+
+    tbb::enumerable_thread_specific<std::set<std::string>> assetPaths;
+    WorkParallelForN(
+        specs.size(),
+        [&specs, &assetPaths](size_t begin, size_t end) {
+            std::set<std::string> &local = assetPaths.local();
+            for (size_t i = begin; i != end; ++i) {
+                for (const _FieldValuePair &field : specs[i]->fields) {
+                    _AddCompositionAssetDependencies(
+                        field.first, field.second, &local);
+                }
+            }
+        });
+
+    std::set<std::string> result;
+    for (const std::set<std::string> &local : assetPaths) {
+        result.insert(local.begin(), local.end());
+    }
+    return result;
+}
+
+SdfAbstractDataMemoryUsage
+SdfData::GetMemoryUsage() const
+{
+    TRACE_FUNCTION();
+
+    std::vector<const _SpecData *> specs;
+    specs.reserve(_data.size());
+    for (const auto &entry : _data) {
+        specs.push_back(&entry.second);
+    }
+
+    tbb::enumerable_thread_specific<SdfAbstractDataMemoryUsage> usages;
+    WorkParallelForN(
+        specs.size(),
+        [&specs, &usages](size_t begin, size_t end) {
+            SdfAbstractDataMemoryUsage &local = usages.local();
+            for (size_t i = begin; i != end; ++i) {
+                const std::vector<_FieldValuePair> &fields = specs[i]->fields;
+                local.fieldBytes +=
+                    fields.capacity() * sizeof(_FieldValuePair);
+                for (const _FieldValuePair &field : fields) {
+                    _AddValueMemoryUsage(field.second, &local);
+                }
+            }
+        });
+
+    // Each entry in the hash table is a separately allocated node holding
+    // the key, the value and the chain link.
+    SdfAbstractDataMemoryUsage result;
+    result.specTableBytes =
+        _data.bucket_count() * sizeof(void *) +
+        _data.size() * (sizeof(_HashTable::value_type) + sizeof(void *));
+    for (const SdfAbstractDataMemoryUsage &local : usages) {
+        result += local;
+    }
+    return result;
+}
+
 bool 
 SdfData::Has(const SdfPath &path, const TfToken &field,
              SdfAbstractDataValue* value) const
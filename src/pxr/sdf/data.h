@@ -89,6 +89,12 @@ public:
     SDF_API
     virtual std::vector<TfToken> List(const SdfPath& path) const;
 
+    SDF_API
+    virtual std::set<std::string> GetCompositionAssetDependencies() const;
+
+    SDF_API
+    virtual SdfAbstractDataMemoryUsage GetMemoryUsage() const;
+
     SDF_API
     virtual std::set<double>
     ListAllTimeSamples() const;
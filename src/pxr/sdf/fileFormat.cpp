@@ -12,6 +12,7 @@
 #include "pxr/sdf/assetPathResolver.h"
 #include "pxr/sdf/data.h"
 #include "pxr/sdf/fileFormatRegistry.h"
+#include "pxr/sdf/fileIO.h"
 #include "pxr/sdf/layer.h"
 #include "pxr/sdf/layerHints.h"
 
@@ -584,6 +585,22 @@ SdfFileFormat::_GetLayerData(const SdfLayer& layer)
     return layer._GetData();
 }
 
+Sdf_RootPrimTextCache *
+SdfFileFormat::_GetRootPrimTextCache(const SdfLayer& layer)
+{
+    std::unique_ptr<Sdf_RootPrimTextCache> &cache = layer._rootPrimTextCache;
+    if (!cache) {
+        cache.reset(new Sdf_RootPrimTextCache);
+    }
+
+    const SdfAbstractDataConstPtr data = layer._GetData();
+    if (cache->data != data) {
+        cache->entries.clear();
+        cache->data = data;
+    }
+    return cache.get();
+}
+
 /* virtual */
 SdfLayer*
 SdfFileFormat::_InstantiateNewLayer(
@@ -28,6 +28,7 @@
 SDF_NAMESPACE_OPEN_SCOPE
 
 class ArAssetInfo;
+class Sdf_RootPrimTextCache;
 class SdfSchemaBase;
 class SdfLayerHints;
 
@@ -443,6 +444,12 @@ protected:
     SDF_API
     static SdfAbstractDataConstPtr _GetLayerData(const SdfLayer& layer);
 
+    /// Get the cache of root prim text kept by \p layer for incremental
+    /// saves, creating an empty cache if it has none.  The cache is emptied
+    /// if the layer's data has been replaced since it was filled.
+    SDF_API
+    static Sdf_RootPrimTextCache *_GetRootPrimTextCache(const SdfLayer& layer);
+
     /// Helper function for _ReadDetached.
     ///
     /// Calls Read with the given parameters. If successful and \p layer is
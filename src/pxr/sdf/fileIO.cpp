@@ -92,6 +92,11 @@ Sdf_TextOutput::RequestWriteVersionUpgrade(const SdfFileVersion& ver,
         return false;
     }
 
+    if (_capture && (!_captureVersion || _captureVersion < ver)) {
+        _captureVersion = ver;
+        _captureReason = reason;
+    }
+
     if (!_requestedVersion.CanRead(ver)) {
         TF_WARN("Upgrading usda file '%s' from version %s to %s: %s",
                 _name.c_str(),
@@ -9,17 +9,21 @@
 #define PXR_SDF_FILE_IO_H
 
 #include "pxr/sdf/pxr.h"
+#include "pxr/sdf/abstractData.h"
 #include "pxr/sdf/fileVersion.h"
 #include <pxr/ar/ar.h>
 
 #include <pxr/ar/writableAsset.h>
 #include <pxr/tf/diagnosticLite.h>
+#include <pxr/tf/token.h>
 
 #include <algorithm>
 #include <cstring>
 #include <memory>
 #include <ostream>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 
 SDF_NAMESPACE_OPEN_SCOPE
 
@@ -155,6 +159,25 @@ public:
     SDF_API
     bool RequestWriteVersionUpgrade(const SdfFileVersion& ver, std::string reason);
 
+    // Start copying everything written to this output into \p capture, and
+    // tracking the version upgrades requested, until EndCapture is called.
+    void BeginCapture(std::string *capture)
+    {
+        _capture = capture;
+        _captureVersion = SdfFileVersion();
+        _captureReason.clear();
+    }
+
+    // Stop capturing output.  Set \p version to the highest version
+    // requested while capturing, or to an invalid version if there was no
+    // request, and \p reason to the reason given for that request.
+    void EndCapture(SdfFileVersion *version, std::string *reason)
+    {
+        _capture = nullptr;
+        *version = _captureVersion;
+        *reason = std::move(_captureReason);
+    }
+
 private:
     // Potentially update the version string in the header of the output
     // file. This should be the last output when writing a usda text file and
@@ -169,6 +192,10 @@ private:
 
     bool _Write(const char* str, size_t strLength)
     {
+        if (_capture) {
+            _capture->append(str, strLength);
+        }
+
         // Much of the text format writing code writes small number of
         // characters at a time. Buffer writes to batch writes into larger
         // chunks.
@@ -233,6 +260,32 @@ private:
     SdfFileVersion _writtenVersion;
     SdfFileVersion _requestedVersion;
     std::string _name;
+
+    std::string *_capture = nullptr;
+    SdfFileVersion _captureVersion;
+    std::string _captureReason;
+};
+
+// Text written for the root prims of a layer by the usda file format when
+// saving, kept by the layer so that later saves can reuse the text of root
+// prims that have not changed.  SdfLayer erases the entry for a root prim
+// whenever the change manager is told about an edit beneath it.
+class Sdf_RootPrimTextCache
+{
+public:
+    struct Entry {
+        std::string text;
+        // Version upgrade requested while writing the text, if any.
+        SdfFileVersion requiredVersion;
+        std::string upgradeReason;
+    };
+
+    // The layer data the text was written from.  If the layer's data has
+    // been replaced since, no entry is valid.
+    SdfAbstractDataConstPtr data;
+
+    // Text for each root prim, by name.
+    std::unordered_map<TfToken, Entry, TfToken::HashFunctor> entries;
 };
 
 // Helper class for writing out strings for the text file format
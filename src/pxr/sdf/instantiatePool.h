@@ -19,6 +19,11 @@
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/pool.h"
 
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 SDF_NAMESPACE_OPEN_SCOPE
 
 // Helper to reserve a region of virtual address space.
@@ -30,6 +35,14 @@ Sdf_PoolReserveRegion(size_t numBytes);
 SDF_API bool
 Sdf_PoolCommitRange(char *start, char *end);
 
+// Helper to return the whole pages in a committed range of bytes to the
+// system.  The range's contents are lost, and on some platforms it may not be
+// accessed again until it is committed with Sdf_PoolCommitRange().  Return
+// the number of bytes released, which excludes the partial pages at either
+// end of the range.
+SDF_API size_t
+Sdf_PoolReleaseRange(char *start, char *end);
+
 template <class Tag,
           unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
 typename Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_ThreadData
@@ -52,6 +65,16 @@ TfStaticData<tbb::concurrent_queue<
     typename Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_FreeList>>
 Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_sharedFreeLists;
 
+template <class Tag,
+          unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
+TfStaticData<tbb::concurrent_queue<
+    typename Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_ReleasedSpan>>
+Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_releasedSpans;
+
+template <class Tag,
+          unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
+typename Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_Counters
+Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_counters;
 
 template <class Tag,
           unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
@@ -124,6 +147,24 @@ template <class Tag,
 void
 Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_ReserveSpan(_PoolSpan &out)
 {
+    // Prefer spans whose memory was released, so that fresh address space is
+    // only consumed once those are used up.
+    _ReleasedSpan released;
+    if (ARCH_UNLIKELY(!_releasedSpans->empty()) &&
+        _releasedSpans->try_pop(released)) {
+        out = released.span;
+        Sdf_PoolCommitRange(_GetPtr(out.region, out.beginIndex),
+                            _GetPtr(out.region, out.endIndex));
+        // Only the released pages count as committed again; the rest of the
+        // span stayed committed.
+        _counters.releasedBytes.fetch_sub(
+            released.numBytes, std::memory_order_relaxed);
+        _counters.committedBytes.fetch_add(
+            released.numBytes, std::memory_order_relaxed);
+        _counters.handedOut.fetch_add(out.size(), std::memory_order_relaxed);
+        return;
+    }
+
     // Read current state.  The state will either be locked, or will have
     // some remaining space available.
     _RegionState state = _regionState.load(std::memory_order_relaxed);
@@ -195,6 +236,137 @@ Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::_ReserveSpan(_PoolSpan &out)
     char *startAddr = _GetPtr(out.region, out.beginIndex);
     char *endAddr = _GetPtr(out.region, out.endIndex);
     Sdf_PoolCommitRange(startAddr, endAddr);
+    _counters.committedBytes.fetch_add(
+        endAddr - startAddr, std::memory_order_relaxed);
+    _counters.handedOut.fetch_add(out.size(), std::memory_order_relaxed);
+}
+
+template <class Tag,
+          unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
+size_t
+Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::ReleaseUnusedMemory(
+    void (*waitForReaders)())
+{
+    // Only one release runs at a time.  Allocation and Free proceed
+    // concurrently; they never see the shared lists taken here.
+    static std::mutex releaseMutex;
+    std::lock_guard<std::mutex> lock(releaseMutex);
+
+    // Take every shared free list.
+    std::vector<_FreeList> freeLists;
+    _FreeList freeList;
+    while (_TakeSharedFreeList(freeList)) {
+        freeLists.push_back(freeList);
+    }
+    if (freeLists.empty()) {
+        return 0;
+    }
+
+    auto next = [](Handle h) {
+        return *reinterpret_cast<Handle *>(h.GetPtr());
+    };
+    auto spanKey = [](_PoolSpan const &span) {
+        return (uint64_t(span.region) << 32) | span.beginIndex;
+    };
+
+    // Count the free elements in each span.  A span is reserved whole, so if
+    // every one of its elements is on a list we hold, no thread can be
+    // allocating from it or holding its elements in a local free list.
+    std::unordered_map<uint64_t, uint32_t> freeCounts;
+    for (_FreeList const &fl: freeLists) {
+        for (Handle h = fl.head; h; h = next(h)) {
+            ++freeCounts[spanKey(_GetSpanFor(h))];
+        }
+    }
+
+    std::unordered_set<uint64_t> releasable;
+    for (auto const &keyAndCount: freeCounts) {
+        const Handle first(static_cast<unsigned>(keyAndCount.first >> 32),
+                           static_cast<uint32_t>(keyAndCount.first));
+        if (keyAndCount.second == _GetSpanFor(first).size()) {
+            releasable.insert(keyAndCount.first);
+        }
+    }
+
+    // Rebuild the shared free lists without the elements of releasable spans.
+    // If nothing is releasable this just puts the lists back.
+    _FreeList kept;
+    for (_FreeList const &fl: freeLists) {
+        if (releasable.empty()) {
+            freeList = fl;
+            _ShareFreeList(freeList);
+            continue;
+        }
+        for (Handle h = fl.head; h; ) {
+            const Handle nextHandle = next(h);
+            if (!releasable.count(spanKey(_GetSpanFor(h)))) {
+                kept.Push(h);
+                if (kept.size >= ElemsPerSpan) {
+                    _ShareFreeList(kept);
+                }
+            }
+            h = nextHandle;
+        }
+    }
+    if (kept.size) {
+        _ShareFreeList(kept);
+    }
+
+    // Let threads that may still be reading elements of these spans finish
+    // before their memory goes away.
+    if (waitForReaders && !releasable.empty()) {
+        waitForReaders();
+    }
+
+    // Return the releasable spans' memory and set the spans aside for reuse.
+    size_t numBytes = 0;
+    for (uint64_t key: releasable) {
+        const _PoolSpan span = _GetSpanFor(
+            Handle(static_cast<unsigned>(key >> 32),
+                   static_cast<uint32_t>(key)));
+        const size_t spanBytes = Sdf_PoolReleaseRange(
+            _GetPtr(span.region, span.beginIndex),
+            _GetPtr(span.region, span.endIndex));
+        numBytes += spanBytes;
+        _counters.handedOut.fetch_sub(span.size(), std::memory_order_relaxed);
+        _releasedSpans->push(_ReleasedSpan { span, spanBytes });
+    }
+    _counters.committedBytes.fetch_sub(numBytes, std::memory_order_relaxed);
+    _counters.releasedBytes.fetch_add(numBytes, std::memory_order_relaxed);
+    return numBytes;
+}
+
+template <class Tag,
+          unsigned ElemSize, unsigned RegionBits, unsigned ElemsPerSpan>
+Sdf_PoolStats
+Sdf_Pool<Tag, ElemSize, RegionBits, ElemsPerSpan>::GetStats()
+{
+    Sdf_PoolStats stats;
+
+    // Count the regions reserved so far.  If a new region is being reserved
+    // right now, the region count lags by one.
+    unsigned numRegions = 0;
+    for (unsigned region = 1; region != NumRegions+1; ++region) {
+        if (!_regionStarts[region]) {
+            break;
+        }
+        ++numRegions;
+    }
+    stats.reservedBytes = numRegions * ElemsPerRegion * ElemSize;
+
+    // The counters are updated independently, so clamp in case a reader
+    // observes a shared free list before the span that it came from.
+    const size_t handedOut =
+        _counters.handedOut.load(std::memory_order_relaxed);
+    stats.freeListElements =
+        _counters.sharedFree.load(std::memory_order_relaxed);
+    stats.liveElements = handedOut > stats.freeListElements ?
+        handedOut - stats.freeListElements : 0;
+    stats.committedBytes =
+        _counters.committedBytes.load(std::memory_order_relaxed);
+    stats.releasedBytes =
+        _counters.releasedBytes.load(std::memory_order_relaxed);
+    return stats;
 }
 
 // Source file definition of an Sdf_Pool instantiation.
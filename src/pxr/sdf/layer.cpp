@@ -17,11 +17,13 @@
 #include "pxr/sdf/childrenUtils.h"
 #include "pxr/sdf/debugCodes.h"
 #include "pxr/sdf/fileFormat.h"
+#include "pxr/sdf/fileIO.h"
 #include "pxr/sdf/layerRegistry.h"
 #include "pxr/sdf/layerStateDelegate.h"
 #include "pxr/sdf/layerUtils.h"
 #include "pxr/sdf/notice.h"
 #include "pxr/sdf/path.h"
+#include "pxr/sdf/pathSortedSet.h"
 #include "pxr/sdf/primSpec.h"
 #include "pxr/sdf/reference.h"
 #include "pxr/sdf/relationshipSpec.h"
@@ -52,16 +54,21 @@
 #include <pxr/tf/stackTrace.h>
 #include <pxr/work/withScopedParallelism.h>
 
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/queuing_rw_mutex.h>
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 using std::map;
@@ -133,7 +140,9 @@ TF_MAKE_STATIC_DATA(SdfLayer::DetachedLayerRules, _detachedLayerRules)
 // A registry for loaded layers.
 static TfStaticData<Sdf_LayerRegistry> _layerRegistry;
 
-// Global mutex protecting _layerRegistry.
+// Global mutex serializing modifications of _layerRegistry, and making finding
+// or creating a layer atomic.  Lookups that only need an existing layer can
+// use Sdf_LayerRegistry::FindAndAcquire without it.
 static tbb::queuing_rw_mutex &
 _GetLayerRegistryMutex() {
     static tbb::queuing_rw_mutex mutex;
@@ -798,7 +807,18 @@ SdfLayer::FindOrOpen(const string &identifier,
         return TfNullPtr;
     }
 
-    // First see if this layer is already present.
+    // First see if this layer is already present.  The registry can be
+    // searched without the registry mutex, which we only need to take if the
+    // layer is missing or expiring.
+    if (SdfLayerRefPtr layer = _layerRegistry->FindAndAcquire(
+            layerInfo.identifier, layerInfo.resolvedLayerPath)) {
+        if (layer->_WaitForInitializationAndCheckIfSuccessful()) {
+            return layer;
+        }
+        return TfNullPtr;
+    }
+    TRACE_COUNTER_DELTA("SdfLayer registry lookups under registry mutex", 1);
+
     tbb::queuing_rw_mutex::scoped_lock
         lock(_GetLayerRegistryMutex(), /*write=*/false);
     if (SdfLayerRefPtr layer =
@@ -868,6 +888,213 @@ SdfLayer::FindOrOpenRelativeToLayer(
         SdfComputeAssetPathRelativeToLayer(anchor, identifier), args);
 }
 
+/* static */
+SdfLayerRefPtrVector
+SdfLayer::FindOrOpenMany(
+    const vector<string> &identifiers,
+    const FileFormatArguments &args,
+    vector<string> *errors)
+{
+    TRACE_FUNCTION();
+    TF_DEBUG(SDF_LAYER).Msg(
+        "SdfLayer::FindOrOpenMany(%zu identifiers, '%s')\n",
+        identifiers.size(), TfStringify(args).c_str());
+
+    // Drop the GIL, as in FindOrOpen.
+    TF_PY_ALLOW_THREADS_IN_SCOPE();
+
+    struct _Request {
+        const string *identifier = nullptr;
+        _FindOrOpenLayerInfo info;
+        bool canOpen = false;
+        // True if the layer was created by this call and still needs to be
+        // read, false if it was found in the registry.
+        bool isNew = false;
+        // Index of the request that opens the same layer as this one.
+        size_t canonical = 0;
+        SdfLayerRefPtr layer;
+        string errors;
+    };
+
+    // If the caller wants errors reported per layer, collect the errors
+    // issued since mark and clear them instead of posting them.
+    auto captureErrors = [errors](TfErrorMark &mark, string *out) {
+        if (errors && !mark.IsClean()) {
+            std::vector<string> messages;
+            if (!out->empty()) {
+                messages.push_back(std::move(*out));
+            }
+            for (const TfError &error : mark) {
+                messages.push_back(error.GetCommentary());
+            }
+            *out = TfStringJoin(messages, "\n");
+            mark.Clear();
+        }
+    };
+
+    // Dedupe identical identifiers.
+    vector<_Request> requests;
+    vector<size_t> requestIndices(identifiers.size());
+    {
+        std::unordered_map<string, size_t> seen;
+        for (size_t i = 0; i != identifiers.size(); ++i) {
+            auto insertResult = seen.emplace(identifiers[i], requests.size());
+            if (insertResult.second) {
+                requests.emplace_back();
+                requests.back().identifier = &identifiers[i];
+                requests.back().canonical = requests.size() - 1;
+            }
+            requestIndices[i] = insertResult.first->second;
+        }
+    }
+
+    // Resolver contexts are bound per thread, so bind the caller's context in
+    // each task to resolve and read layers as FindOrOpen would.
+    const ArResolverContext context = ArGetResolver().GetCurrentContext();
+
+    // Isolate.
+    WorkWithScopedParallelism([&]() {
+
+        // Resolve all identifiers in parallel.  Errors that are not captured
+        // are transported to this thread by the dispatcher.
+        WorkDispatcher dispatcher;
+        for (_Request &req : requests) {
+            dispatcher.Run([&req, &args, &captureErrors, &context]() {
+                ArResolverContextBinder binder(context);
+                TfErrorMark m;
+                req.canOpen = _ComputeInfoToFindOrOpenLayer(
+                    *req.identifier, args, &req.info,
+                    /* computeAssetInfo = */ true);
+                captureErrors(m, &req.errors);
+            });
+        }
+        dispatcher.Wait();
+
+        // Find existing layers and register new ones with a single
+        // acquisition of the registry lock.  No layer references may be
+        // dropped while the lock is held, since destroying a layer takes the
+        // lock as well.
+        {
+            std::unordered_map<string, size_t> canonicalIndices;
+            std::unordered_map<const SdfLayer *, size_t> createdIndices;
+
+            tbb::queuing_rw_mutex::scoped_lock lock(_GetLayerRegistryMutex());
+            for (size_t i = 0; i != requests.size(); ++i) {
+                _Request &req = requests[i];
+                if (!req.canOpen) {
+                    continue;
+                }
+
+                // Identifiers that differ only in spelling may still name
+                // the same layer once resolved.  Redirect to the earlier
+                // request's own canonical request, which was already
+                // resolved, so that chains of redirects collapse to the
+                // request that holds the layer.
+                auto insertResult =
+                    canonicalIndices.emplace(req.info.identifier, i);
+                if (!insertResult.second) {
+                    req.canonical =
+                        requests[insertResult.first->second].canonical;
+                    continue;
+                }
+
+                if (SdfLayerHandle layer = _layerRegistry->Find(
+                        req.info.identifier, req.info.resolvedLayerPath)) {
+                    auto created = createdIndices.find(get_pointer(layer));
+                    if (created != createdIndices.end()) {
+                        // Created earlier in this batch under another
+                        // identifier with the same resolved path.
+                        req.canonical = requests[created->second].canonical;
+                        continue;
+                    }
+                    req.layer = TfCreateRefPtrFromProtectedWeakPtr(layer);
+                    if (req.layer) {
+                        continue;
+                    }
+                    // The layer is expiring, remove it from the registry as
+                    // _TryToFindLayer does.
+                    _layerRegistry->Erase(layer, *layer->_assetInfo);
+                }
+
+                if (req.info.isAnonymous) {
+                    if (!req.info.fileFormat ||
+                        !req.info.fileFormat->ShouldReadAnonymousLayers()) {
+                        continue;
+                    }
+                }
+                else if (req.info.resolvedLayerPath.empty()) {
+                    continue;
+                }
+
+                TfErrorMark m;
+                if (!req.info.fileFormat) {
+                    TF_CODING_ERROR("Cannot determine file format for @%s@",
+                                    req.info.identifier.c_str());
+                }
+                else {
+                    req.layer = _CreateNewWithFormat(
+                        req.info.fileFormat, req.info.identifier,
+                        req.info.resolvedLayerPath, req.info.assetInfo,
+                        req.info.fileFormatArgs);
+                    req.isNew = true;
+                    createdIndices.emplace(get_pointer(req.layer), i);
+                }
+                captureErrors(m, &req.errors);
+            }
+        }
+
+        // Read the newly registered layers in parallel.
+        for (_Request &req : requests) {
+            if (!req.isNew) {
+                continue;
+            }
+            dispatcher.Run([&req, &captureErrors, &context]() {
+                ArResolverContextBinder binder(context);
+                TfErrorMark m;
+                try {
+                    req.layer = _ReadNewlyRegisteredLayer(
+                        req.layer, req.info, /* metadataOnly */ false);
+                } catch (std::exception &e) {
+                    TF_RUNTIME_ERROR(
+                        "Exception thrown while opening layer: %s", e.what());
+                    if (!req.layer->_initializationComplete) {
+                        req.layer->_FinishInitialization(/* success = */ false);
+                    }
+                    req.layer = TfNullPtr;
+                }
+                captureErrors(m, &req.errors);
+            });
+        }
+        dispatcher.Wait();
+    });
+
+    // Layers found in the registry may still be initializing in other
+    // threads.
+    for (_Request &req : requests) {
+        if (req.layer && !req.isNew &&
+            !req.layer->_WaitForInitializationAndCheckIfSuccessful()) {
+            req.layer = TfNullPtr;
+        }
+    }
+
+    SdfLayerRefPtrVector result(identifiers.size());
+    if (errors) {
+        errors->assign(identifiers.size(), string());
+    }
+    for (size_t i = 0; i != identifiers.size(); ++i) {
+        const _Request &req = requests[requestIndices[i]];
+        const _Request &canonicalReq = requests[req.canonical];
+        result[i] = canonicalReq.layer;
+        if (errors) {
+            (*errors)[i] = &req == &canonicalReq || req.errors.empty() ?
+                canonicalReq.errors :
+                TfStringJoin(std::vector<string>{
+                        req.errors, canonicalReq.errors}, "\n");
+        }
+    }
+    return result;
+}
+
 /* static */
 SdfLayerRefPtr
 SdfLayer::OpenAsAnonymous(
@@ -1156,7 +1383,19 @@ SdfLayer::_Find(const string &identifier,
         return TfNullPtr;
     }
 
-    // First see if this layer is already present.
+    // First see if this layer is already present.  Unless the caller needs
+    // the registry mutex to be held for writing when the layer is missing,
+    // the registry can be searched without it.  A missing or expiring layer
+    // is reported as not found either way; the expiring layer's destructor
+    // removes it from the registry.
+    if (!retryAsWriter) {
+        SdfLayerRefPtr layer = _layerRegistry->FindAndAcquire(
+            layerInfo.identifier, layerInfo.resolvedLayerPath);
+        return layer && layer->_WaitForInitializationAndCheckIfSuccessful() ?
+            layer : TfNullPtr;
+    }
+    TRACE_COUNTER_DELTA("SdfLayer registry lookups under registry mutex", 1);
+
     lock.acquire(_GetLayerRegistryMutex(), /*write=*/false);
     if (SdfLayerRefPtr layer = _TryToFindLayer(
             layerInfo.identifier, layerInfo.resolvedLayerPath,
@@ -2485,22 +2724,46 @@ SdfLayer::RemovePropertyIfHasOnlyRequiredFields(SdfPropertySpecHandle prop)
 void
 SdfLayer::RemoveInertSceneDescription()
 {
+    TRACE_FUNCTION();
+
     SdfChangeBlock block;
 
-    _RemoveInertDFS(GetPseudoRoot());
+    // Prims only become removable if they are inert or all of their
+    // children are removed, so only subtrees containing inert prims need to
+    // be visited.  Find those in parallel before removing anything.
+    const SdfPathVector inertPrims =
+        _FindInertPrims(SdfPath::AbsoluteRootPath());
+    if (!inertPrims.empty()) {
+        _RemoveInertDFS(GetPseudoRoot(), &inertPrims);
+    }
 }
 
 bool
-SdfLayer::_RemoveInertDFS(SdfPrimSpecHandle prim)
-{
-    bool inert = prim->IsInert();
+SdfLayer::_RemoveInertDFS(SdfPrimSpecHandle prim,
+                          const SdfPathVector *inertPrims)
+{
+    bool inert;
+    if (inertPrims) {
+        const SdfPath &path = prim->GetPath();
+        const auto range = SdfPathFindPrefixedRange(
+            inertPrims->begin(), inertPrims->end(), path);
+        if (range.first == range.second) {
+            // Neither this prim nor anything below it is inert, so nothing
+            // will be removed.
+            return false;
+        }
+        inert = *range.first == path;
+    }
+    else {
+        inert = prim->IsInert();
+    }
 
     if (!inert) {
         // Child prims
         SdfPrimSpecHandleVector removedChildren;
         TF_FOR_ALL(it, prim->GetNameChildren()) {
             SdfPrimSpecHandle child = *it;
-            if (_RemoveInertDFS(child) &&
+            if (_RemoveInertDFS(child, inertPrims) &&
                 !SdfIsDefiningSpecifier(child->GetSpecifier()))
                 removedChildren.push_back(child);
         }
@@ -2514,7 +2777,7 @@ SdfLayer::_RemoveInertDFS(SdfPrimSpecHandle prim)
             const SdfVariantSpecHandleVector &variants =
                 varSetSpec->GetVariantList();
             TF_FOR_ALL(varIt, variants) {
-                _RemoveInertDFS((*varIt)->GetPrimSpec());
+                _RemoveInertDFS((*varIt)->GetPrimSpec(), inertPrims);
             }
         }
     }
@@ -3095,6 +3358,120 @@ SdfLayer::_UpdateLastDirtinessState() const
     return true;
 }
 
+struct SdfLayer::_ChangeJournal
+{
+    _ChangeJournal(size_t maxEntries_, size_t coveredSerialNumber_)
+        : maxEntries(maxEntries_)
+        , coveredSerialNumber(coveredSerialNumber_)
+    {}
+
+    // Discard the oldest rounds until the journal is within its limit.
+    void Trim() {
+        while (numEntries > maxEntries) {
+            numEntries -= _CountEntries(rounds.front().second);
+            coveredSerialNumber = rounds.front().first;
+            rounds.pop_front();
+        }
+    }
+
+    static size_t _CountEntries(const SdfChangeList &changes) {
+        return std::max<size_t>(changes.GetEntryList().size(), 1);
+    }
+
+    size_t maxEntries;
+    // All rounds sent after this serial number are in the journal.
+    size_t coveredSerialNumber;
+    size_t numEntries = 0;
+    std::deque<ChangeJournalRound> rounds;
+};
+
+// _changeJournal is only accessed with _changeJournalMutex held.
+// _hasChangeJournal lets change processing skip layers without a journal
+// without taking the mutex.  It is set before the journal's covered serial
+// number is read, so a round that misses the journal because it found
+// _hasChangeJournal clear got its serial number before that read and does
+// not need to be in the journal.
+
+void
+SdfLayer::SetChangeJournalLimit(size_t maxEntries)
+{
+    std::lock_guard<std::mutex> lock(_changeJournalMutex);
+    if (maxEntries == 0) {
+        _hasChangeJournal = false;
+        _changeJournal.reset();
+        return;
+    }
+
+    if (_changeJournal) {
+        _changeJournal->maxEntries = maxEntries;
+        _changeJournal->Trim();
+        return;
+    }
+
+    _hasChangeJournal = true;
+    _changeJournal.reset(new _ChangeJournal(
+        maxEntries, Sdf_ChangeManager::Get().GetNextSerialNumber() - 1));
+}
+
+size_t
+SdfLayer::GetChangeJournalLimit() const
+{
+    std::lock_guard<std::mutex> lock(_changeJournalMutex);
+    return _changeJournal ? _changeJournal->maxEntries : 0;
+}
+
+bool
+SdfLayer::GetJournaledChangesSince(
+    size_t serialNumber, std::vector<ChangeJournalRound> *rounds) const
+{
+    if (!rounds) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_changeJournalMutex);
+    if (!_changeJournal ||
+        serialNumber < _changeJournal->coveredSerialNumber) {
+        return false;
+    }
+
+    for (const ChangeJournalRound &round : _changeJournal->rounds) {
+        if (round.first > serialNumber) {
+            rounds->push_back(round);
+        }
+    }
+    return true;
+}
+
+void
+SdfLayer::_RecordChangesInJournal(size_t serialNumber,
+                                  const SdfChangeList &changes)
+{
+    if (!_hasChangeJournal) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_changeJournalMutex);
+    if (!_changeJournal) {
+        return;
+    }
+    _changeJournal->rounds.emplace_back(serialNumber, changes);
+    _changeJournal->numEntries += _ChangeJournal::_CountEntries(changes);
+    _changeJournal->Trim();
+}
+
+void
+SdfLayer::_EraseRootPrimText(const SdfPath &path)
+{
+    // Find the root prim, also through variant selections and targets.
+    SdfPath rootPrimPath = path.GetPrimOrPrimVariantSelectionPath();
+    while (!rootPrimPath.IsEmpty() && !rootPrimPath.IsRootPrimPath()) {
+        rootPrimPath = rootPrimPath.GetParentPath();
+    }
+    if (!rootPrimPath.IsEmpty()) {
+        _rootPrimTextCache->entries.erase(rootPrimPath.GetNameToken());
+    }
+}
+
 SdfLayerStateDelegateBasePtr 
 SdfLayer::GetStateDelegate() const
 {
@@ -3159,6 +3536,82 @@ SdfLayer::IsDetached() const
     return _GetData()->IsDetached();
 }
 
+SdfAbstractDataMemoryUsage
+SdfLayer::GetMemoryUsage() const
+{
+    return _GetData()->GetMemoryUsage();
+}
+
+bool
+SdfLayer::PageOut()
+{
+    if (IsDirty() || IsAnonymous() || !_data->StreamsData()) {
+        return false;
+    }
+    return _data->PageOut();
+}
+
+bool
+SdfLayer::IsPagedOut() const
+{
+    return _GetData()->IsPagedOut();
+}
+
+size_t
+SdfLayer::PageOutLayers(size_t maxResidentBytes)
+{
+    TRACE_FUNCTION();
+
+    struct _Candidate {
+        SdfLayerHandle layer;
+        size_t lastAccessEpoch;
+        size_t bytes;
+    };
+
+    // Accesses from here on rank ahead of every access recorded so far.
+    SdfAbstractData::AdvanceAccessEpoch();
+
+    std::vector<_Candidate> candidates;
+    size_t residentBytes = 0;
+    for (const SdfLayerHandle &layer : GetLoadedLayers()) {
+        if (!layer) {
+            continue;
+        }
+        SdfAbstractDataConstPtr data = layer->_GetData();
+        const size_t lastAccessEpoch = data->GetLastAccessEpoch();
+        data->ResetAccessTracking();
+        if (layer->IsPagedOut() || !layer->StreamsData() ||
+            layer->IsDirty() || layer->IsAnonymous()) {
+            continue;
+        }
+        const SdfAbstractDataMemoryUsage usage = layer->GetMemoryUsage();
+        const size_t bytes = usage.GetTotalBytes() + usage.mappedBytes;
+        residentBytes += bytes;
+        candidates.push_back({ layer, lastAccessEpoch, bytes });
+    }
+
+    // Least recently accessed first, and larger layers first among those
+    // last accessed in the same epoch.
+    std::sort(candidates.begin(), candidates.end(),
+              [](const _Candidate &a, const _Candidate &b) {
+                  return a.lastAccessEpoch != b.lastAccessEpoch ?
+                      a.lastAccessEpoch < b.lastAccessEpoch :
+                      a.bytes > b.bytes;
+              });
+
+    size_t numPagedOut = 0;
+    for (const _Candidate &candidate : candidates) {
+        if (residentBytes <= maxResidentBytes) {
+            break;
+        }
+        if (candidate.layer->PageOut()) {
+            residentBytes -= candidate.bytes;
+            ++numPagedOut;
+        }
+    }
+    return numPagedOut;
+}
+
 void
 SdfLayer::TransferContent(const SdfLayerHandle& layer)
 {
@@ -3207,42 +3660,6 @@ SdfLayer::TransferContent(const SdfLayerHandle& layer)
     }
 }
 
-static void
-_GatherPrimCompositionDependencies(const SdfPrimSpecHandle &prim,
-                                   set<string> *assetReferences)
-{
-    if (prim != prim->GetLayer()->GetPseudoRoot()) {
-        // Prim references
-        for (const SdfReference &ref:
-             prim->GetReferenceList().GetAddedOrExplicitItems()) {
-            assetReferences->insert(ref.GetAssetPath());
-        }
-
-        // Prim payloads
-        for (const SdfPayload &payload:
-             prim->GetPayloadList().GetAddedOrExplicitItems()) {
-            assetReferences->insert(payload.GetAssetPath());
-        }
-
-        // Prim variants
-        SdfVariantSetsProxy variantSetMap = prim->GetVariantSets();
-        for (const auto &varSetIt: variantSetMap) {
-            const SdfVariantSetSpecHandle &varSetSpec = varSetIt.second;
-            const SdfVariantSpecHandleVector &variants =
-                varSetSpec->GetVariantList();
-            for(const SdfVariantSpecHandle &varSpec : variants) {
-                _GatherPrimCompositionDependencies( 
-                    varSpec->GetPrimSpec(), assetReferences );
-            }
-        }
-    }
-
-    // Recurse on nameChildren
-    for (const SdfPrimSpecHandle &child : prim->GetNameChildren()) {
-        _GatherPrimCompositionDependencies(child, assetReferences);
-    }
-}
-
 set<string>
 SdfLayer::GetExternalReferences() const
 {
@@ -3260,13 +3677,11 @@ SdfLayer::UpdateExternalReference(
 set<string>
 SdfLayer::GetCompositionAssetDependencies() const
 {
-    SdfSubLayerProxy subLayers = GetSubLayerPaths();
-
-    set<string> results(subLayers.begin(), subLayers.end());
-
-    _GatherPrimCompositionDependencies(GetPseudoRoot(), &results);
+    TRACE_FUNCTION();
 
-    return results;
+    // Let the data answer this directly from its own representation rather
+    // than walking the prim hierarchy through spec handles.
+    return _data->GetCompositionAssetDependencies();
 }
 
 bool
@@ -3440,6 +3855,15 @@ SdfLayer::_OpenLayerAndUnlockRegistry(
 
     lock.release();
 
+    return _ReadNewlyRegisteredLayer(std::move(layer), info, metadataOnly);
+}
+
+SdfLayerRefPtr
+SdfLayer::_ReadNewlyRegisteredLayer(
+    SdfLayerRefPtr layer,
+    const _FindOrOpenLayerInfo& info,
+    bool metadataOnly)
+{
     // From this point on, we need to be sure to call
     // layer->_FinishInitialization() with either success or failure,
     // in order to unblock any other threads waiting for initialization
@@ -4163,6 +4587,7 @@ SdfLayer::_ProcessIncomingData(const SdfAbstractDataPtr &newData,
                         const ErrorFunc &errorFunc) const
 {
     const bool differentSchema = newDataSchema && newDataSchema != &GetSchema();
+
     // Remove specs that no longer exist or whose required fields changed.
     {
         // Collect specs to delete, ordered by namespace.
@@ -4175,7 +4600,7 @@ SdfLayer::_ProcessIncomingData(const SdfAbstractDataPtr &newData,
             {
                 if (!newData->HasSpec(path) ||
                     (newData->GetSpecType(path) != oldData.GetSpecType(path))) {
-                    paths.insert(path);
+                    paths.push_back(path);
                 }
                 return true;
             }
@@ -4186,16 +4611,17 @@ SdfLayer::_ProcessIncomingData(const SdfAbstractDataPtr &newData,
             }
 
             const SdfAbstractDataRefPtr newData;
-            std::set<SdfPath> paths;
+            SdfPathVector paths;
         };
 
         _SpecsToDelete specsToDelete(newData);
         _data->VisitSpecs(&specsToDelete);
+        const SdfPathSortedSet pathsToDelete(std::move(specsToDelete.paths));
 
         // Delete specs bottom-up to provide optimal diffs.
         // Erase fields first, to take advantage of the more efficient
         // update possible when removing inert specs.
-        TF_REVERSE_FOR_ALL(i, specsToDelete.paths) {
+        TF_REVERSE_FOR_ALL(i, pathsToDelete.GetPaths()) {
             const SdfPath &path = *i;
 
             if (!processPropertyFields && path.IsPropertyPath()) {
@@ -4235,7 +4661,7 @@ SdfLayer::_ProcessIncomingData(const SdfAbstractDataPtr &newData,
                 const SdfAbstractData& newData, const SdfPath& path)
             {
                 if (!oldData.HasSpec(path)) {
-                    paths.insert(path);
+                    paths.push_back(path);
                 }
                 return true;
             }
@@ -4246,16 +4672,17 @@ SdfLayer::_ProcessIncomingData(const SdfAbstractDataPtr &newData,
             }
 
             const SdfAbstractData& oldData;
-            std::set<SdfPath> paths;
+            SdfPathVector paths;
         };
 
         _SpecsToCreate specsToCreate(*get_pointer(_data));
         newData->VisitSpecs(&specsToCreate);
+        const SdfPathSortedSet pathsToCreate(std::move(specsToCreate.paths));
 
         SdfPath unrecognizedSpecTypePaths[SdfNumSpecTypes];
 
         // Create specs top-down to provide optimal diffs.
-        TF_FOR_ALL(i, specsToCreate.paths) {
+        TF_FOR_ALL(i, pathsToCreate) {
             const SdfPath& path = *i;
 
             // Determine if the spec is inert based on its fields.
@@ -4470,15 +4897,24 @@ SdfLayer::_PrimSetField(const SdfPath& path,
         return;
     }
 
-    VtValue oldValue = 
-        oldValuePtr ? std::move(*oldValuePtr) : GetField(path, fieldName);
-    const VtValue& newValue = _GetVtValue(value);
-
     // Send notification when leaving the change block.
     SdfChangeBlock block;
 
-    Sdf_ChangeManager::Get().DidChangeField(
-        _self, path, fieldName, std::move(oldValue), newValue);
+    Sdf_ChangeManager &changeManager = Sdf_ChangeManager::Get();
+    if (!changeManager.NeedsFieldValues(fieldName)) {
+        // Avoid fetching the old value and copying the new one when the
+        // change manager only records which field changed.
+        changeManager.DidChangeField(
+            _self, path, fieldName, VtValue(), VtValue());
+    }
+    else {
+        VtValue oldValue = 
+            oldValuePtr ? std::move(*oldValuePtr) : GetField(path, fieldName);
+        const VtValue& newValue = _GetVtValue(value);
+
+        changeManager.DidChangeField(
+            _self, path, fieldName, std::move(oldValue), newValue);
+    }
 
     _data->Set(path, fieldName, value);
 }
@@ -4604,6 +5040,14 @@ SdfLayer::_PrimSetFieldDictValueByKey(const SdfPath& path,
     // Send notification when leaving the change block.
     SdfChangeBlock block;
 
+    Sdf_ChangeManager &changeManager = Sdf_ChangeManager::Get();
+    if (!changeManager.NeedsFieldValues(fieldName)) {
+        _data->SetDictValueByKey(path, fieldName, keyPath, value);
+        changeManager.DidChangeField(
+            _self, path, fieldName, VtValue(), VtValue());
+        return;
+    }
+
     // This can't only use oldValuePtr currently, since we need the entire
     // dictionary, not just they key being set.  If we augment change
     // notification to be as granular as dict-key-path, we could use it.
@@ -4613,7 +5057,7 @@ SdfLayer::_PrimSetFieldDictValueByKey(const SdfPath& path,
 
     VtValue newValue = GetField(path, fieldName);
 
-    Sdf_ChangeManager::Get().DidChangeField(
+    changeManager.DidChangeField(
         _self, path, fieldName, std::move(oldValue), newValue);
 }
 
@@ -4817,6 +5261,150 @@ SdfLayer::Traverse(const SdfPath &path, const TraversalFunction &func)
     func(path);
 }
 
+namespace {
+
+// Helper for ParallelTraverse. Reads the children field of \p ChildPolicy
+// at \p path directly from \p data and appends the child spec paths to
+// \p children.
+template <typename ChildPolicy>
+void
+_AppendChildPaths(const SdfAbstractData &data, const SdfPath &path,
+                  SdfPathVector *children)
+{
+    using FieldType = std::vector<typename ChildPolicy::FieldType>;
+
+    VtValue value;
+    if (!data.Has(path, ChildPolicy::GetChildrenToken(path), &value) ||
+        !value.IsHolding<FieldType>()) {
+        return;
+    }
+
+    const FieldType &keys = value.UncheckedGet<FieldType>();
+    children->reserve(children->size() + keys.size());
+    for (const auto &key : keys) {
+        children->push_back(ChildPolicy::GetChildPath(path, key));
+    }
+}
+
+// Append the paths of all children of the spec at \p path to \p children,
+// consulting only the children fields that may be present on a spec of
+// that type.
+void
+_GetChildPathsForTraversal(const SdfAbstractData &data, const SdfPath &path,
+                           SdfPathVector *children)
+{
+    switch (data.GetSpecType(path)) {
+    case SdfSpecTypePseudoRoot:
+        _AppendChildPaths<Sdf_PrimChildPolicy>(data, path, children);
+        break;
+    case SdfSpecTypePrim:
+    case SdfSpecTypeVariant:
+        _AppendChildPaths<Sdf_PrimChildPolicy>(data, path, children);
+        _AppendChildPaths<Sdf_PropertyChildPolicy>(data, path, children);
+        _AppendChildPaths<Sdf_VariantSetChildPolicy>(data, path, children);
+        break;
+    case SdfSpecTypeVariantSet:
+        _AppendChildPaths<Sdf_VariantChildPolicy>(data, path, children);
+        break;
+    case SdfSpecTypeAttribute:
+        _AppendChildPaths<Sdf_AttributeConnectionChildPolicy>(
+            data, path, children);
+        _AppendChildPaths<Sdf_MapperChildPolicy>(data, path, children);
+        _AppendChildPaths<Sdf_ExpressionChildPolicy>(data, path, children);
+        break;
+    case SdfSpecTypeRelationship:
+        _AppendChildPaths<Sdf_RelationshipTargetChildPolicy>(
+            data, path, children);
+        break;
+    case SdfSpecTypeRelationshipTarget:
+        // Relational attributes.
+        _AppendChildPaths<Sdf_PropertyChildPolicy>(data, path, children);
+        break;
+    case SdfSpecTypeMapper:
+        _AppendChildPaths<Sdf_MapperArgChildPolicy>(data, path, children);
+        break;
+    default:
+        break;
+    }
+}
+
+// Work-stealing traversal helper for SdfLayer::ParallelTraverse. Each task
+// visits a spec, spawns tasks for all but its first child and continues
+// with the first child itself.
+class _ParallelTraverser
+{
+public:
+    _ParallelTraverser(const SdfAbstractData &data,
+                       const SdfLayer::ParallelTraversalFunction &func,
+                       const std::atomic<bool> *cancel)
+        : _data(data)
+        , _func(func)
+        , _cancel(cancel)
+        , _cancelled(false)
+    {}
+
+    bool Run(const SdfPath &root) {
+        _dispatcher.Run([this, root]() { _Visit(root); });
+        _dispatcher.Wait();
+        return !_cancelled;
+    }
+
+private:
+    bool _IsCancelled() {
+        if (_cancelled.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        if (_cancel && _cancel->load(std::memory_order_relaxed)) {
+            _cancelled = true;
+            return true;
+        }
+        return false;
+    }
+
+    void _Visit(SdfPath path) {
+        SdfPathVector children;
+        while (!_IsCancelled() && _func(path)) {
+            children.clear();
+            _GetChildPathsForTraversal(_data, path, &children);
+            if (children.empty()) {
+                return;
+            }
+            for (size_t i = 1, n = children.size(); i != n; ++i) {
+                _dispatcher.Run(
+                    [this, child = std::move(children[i])]() {
+                        _Visit(child);
+                    });
+            }
+            path = std::move(children.front());
+        }
+    }
+
+    const SdfAbstractData &_data;
+    const SdfLayer::ParallelTraversalFunction &_func;
+    const std::atomic<bool> *_cancel;
+    std::atomic<bool> _cancelled;
+    WorkDispatcher _dispatcher;
+};
+
+} // anon
+
+bool
+SdfLayer::ParallelTraverse(const SdfPath &path,
+                           const ParallelTraversalFunction &func,
+                           const std::atomic<bool> *cancel) const
+{
+    TRACE_FUNCTION();
+
+    if (!func) {
+        TF_CODING_ERROR("Invalid traversal function");
+        return false;
+    }
+
+    return WorkWithScopedParallelism([&]() {
+        return _ParallelTraverser(*_data, func, cancel).Run(path);
+    });
+}
+
 static void
 _EraseSpecAtPath(SdfAbstractData* data, const SdfPath& path)
 {
@@ -4942,6 +5530,77 @@ SdfLayer::_IsInert(const SdfPath &path, bool ignoreChildren,
     return false;
 }
 
+SdfPathVector
+SdfLayer::_FindInertPrims(const SdfPath &path) const
+{
+    TRACE_FUNCTION();
+
+    // A local class has the same access to SdfLayer as this method.
+    struct _Finder {
+        explicit _Finder(const SdfLayer &layer_) : layer(layer_) {}
+
+        void Run(const SdfPath &primPath) {
+            if (layer._IsInert(primPath, /*ignoreChildren=*/false)) {
+                inertPrims.local().push_back(primPath);
+                return;
+            }
+
+            // Visit the prim children and the prims in variants, as
+            // _RemoveInertDFS does.
+            SdfPathVector children;
+            std::vector<TfToken> names;
+            if (layer.HasField(
+                    primPath, SdfChildrenKeys->PrimChildren, &names)) {
+                for (const TfToken &name : names) {
+                    children.push_back(primPath.AppendChild(name));
+                }
+            }
+            std::vector<TfToken> variantSets;
+            if (layer.HasField(primPath, SdfChildrenKeys->VariantSetChildren,
+                               &variantSets)) {
+                for (const TfToken &variantSet : variantSets) {
+                    const SdfPath variantSetPath =
+                        primPath.AppendVariantSelection(
+                            variantSet.GetString(), std::string());
+                    if (layer.HasField(variantSetPath,
+                                       SdfChildrenKeys->VariantChildren,
+                                       &names)) {
+                        for (const TfToken &variant : names) {
+                            children.push_back(
+                                primPath.AppendVariantSelection(
+                                    variantSet.GetString(),
+                                    variant.GetString()));
+                        }
+                    }
+                }
+            }
+
+            WorkParallelForN(
+                children.size(),
+                [this, &children](size_t begin, size_t end) {
+                    for (size_t i = begin; i != end; ++i) {
+                        Run(children[i]);
+                    }
+                });
+        }
+
+        const SdfLayer &layer;
+        tbb::enumerable_thread_specific<SdfPathVector> inertPrims;
+    };
+
+    _Finder finder(*this);
+    WorkWithScopedParallelism([&finder, &path]() {
+        finder.Run(path);
+    });
+
+    SdfPathVector result;
+    for (const SdfPathVector &paths : finder.inertPrims) {
+        result.insert(result.end(), paths.begin(), paths.end());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 bool
 SdfLayer::_IsInertSubtree(
     const SdfPath &path) const
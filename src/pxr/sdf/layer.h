@@ -12,6 +12,7 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/api.h"
+#include "pxr/sdf/changeList.h"
 #include "pxr/sdf/data.h"
 #include "pxr/sdf/declareHandles.h"
 #include "pxr/sdf/identity.h"
@@ -32,6 +33,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -44,6 +46,7 @@ TF_DECLARE_WEAK_AND_REF_PTRS(SdfLayerStateDelegateBase);
 
 class SdfChangeList;
 struct Sdf_AssetInfo;
+class Sdf_RootPrimTextCache;
 
 /// \class SdfLayer 
 ///
@@ -78,6 +81,26 @@ struct Sdf_AssetInfo;
 /// contained in the file scales to seconds. For example, if timeCodesPerSecond
 /// is 24, then a sample at time ordinate 24 should be viewed exactly one second
 /// after the sample at time ordinate 0.
+///
+/// \section sdf_layer_concurrent_reads Concurrent reads
+///
+/// While no thread is modifying a layer, any number of threads may read it
+/// concurrently through its const, path-based query API: GetSpecType(),
+/// HasSpec(), ListFields(), HasField(), GetField(), GetFieldAs(),
+/// GetFieldRaw(), HasFieldDictKey(), GetFieldDictValueByKey(), and the
+/// time sample queries.  These calls read the layer's data directly and
+/// take no locks, with two exceptions in data that supports paging (see
+/// PageOut()): the first read of paged out data reopens it, and the first
+/// read after PageOutLayers() records the current access epoch.  Both
+/// happen once, under a lock held by the data, and later reads return to
+/// the lock-free path.  Any edit, save, reload or PageOut() must be
+/// serialized with all readers.
+///
+/// Spec handles are also safe to create and use from multiple threads, but
+/// each one is looked up in the layer's identity registry under a lock and
+/// holds an atomically counted reference to it.  Heavily parallel read
+/// stages should prefer the path-based API, and GetFieldRaw() in particular,
+/// over spec handles.
 /// 
 class SdfLayer 
     : public TfRefBase
@@ -200,6 +223,30 @@ public:
         const SdfLayerHandle &anchor,
         const std::string &identifier,
         const FileFormatArguments &args = FileFormatArguments());
+
+    /// Return the existing layers with the given \p identifiers and \p args,
+    /// or else load them, as if by calling FindOrOpen on each identifier.
+    ///
+    /// The returned vector is parallel to \p identifiers and holds a null
+    /// layer for each identifier that could not be found or loaded.
+    /// Identifiers are resolved and layers are read in parallel, the layer
+    /// registry is locked once for the whole batch to find existing layers
+    /// and register new ones, and identifiers that refer to the same layer
+    /// are only opened once.  Every identifier is resolved with the resolver
+    /// context bound on the calling thread, as in FindOrOpen.
+    ///
+    /// If \p errors is not null, it is resized to match \p identifiers and
+    /// each element receives the commentary of the errors issued while
+    /// opening the corresponding layer; those errors are not posted.
+    /// Otherwise, errors are posted as FindOrOpen would.
+    ///
+    /// Arguments in \p args will override any arguments specified in
+    /// each identifier.
+    SDF_API
+    static SdfLayerRefPtrVector FindOrOpenMany(
+        const std::vector<std::string> &identifiers,
+        const FileFormatArguments &args = FileFormatArguments(),
+        std::vector<std::string> *errors = nullptr);
         
     /// Load the given layer from disk as a new anonymous layer. If the
     /// layer can't be found or loaded, an error is posted and a null
@@ -256,6 +303,49 @@ public:
     SDF_API
     bool IsDetached() const;
 
+    /// Returns an estimate of the memory held by this layer's data, broken
+    /// down by spec table, field storage, values by type, time samples,
+    /// memory mapped file content and file format structural tables.
+    ///
+    /// Each data implementation computes its own share, so this is cheap
+    /// enough to call from cache eviction policies without enabling
+    /// TfMallocTag.
+    ///
+    /// \sa SdfAbstractData::GetMemoryUsage
+    SDF_API
+    SdfAbstractDataMemoryUsage GetMemoryUsage() const;
+
+    /// Releases the in-memory tables and file mapping of this layer if it is
+    /// a clean layer that streams its data from a file, keeping the layer
+    /// and handles to it valid.  The data is reopened from the layer's file
+    /// on the next access.  Returns true if the layer was paged out.
+    ///
+    /// If the file has changed or cannot be read when it is reopened, that
+    /// access reports an error, the layer's content is lost, and saving or
+    /// exporting the layer fails until it is reloaded.
+    ///
+    /// This must not be called while other threads access this layer.
+    SDF_API
+    bool PageOut();
+
+    /// Returns true if this layer's data is currently paged out.
+    /// \sa PageOut
+    SDF_API
+    bool IsPagedOut() const;
+
+    /// Pages out clean streaming layers among the loaded layers, least
+    /// recently accessed first, until the estimated memory of the remaining
+    /// resident ones, including their mapped file content, is at most
+    /// \p maxResidentBytes.  Returns the number of layers paged out.
+    ///
+    /// Recency is measured in access epochs: each call starts a new epoch,
+    /// so layers accessed since the previous call are paged out last.  This
+    /// must not be called while other threads access the loaded layers.
+    ///
+    /// \sa PageOut, SdfAbstractData::GetLastAccessEpoch
+    SDF_API
+    static size_t PageOutLayers(size_t maxResidentBytes);
+
     /// Copies the content of the given layer into this layer.
     /// Source layer is unmodified.
     SDF_API
@@ -417,6 +507,10 @@ public:
     /// payload, and sublayer fields in this layer. This function only returns 
     /// direct composition dependencies of this layer, i.e. it does not recurse 
     /// to find composition dependencies from its dependent layer assets.
+    ///
+    /// The query is answered by the layer's underlying data object without
+    /// traversing the prim hierarchy.
+    /// \sa SdfAbstractData::GetCompositionAssetDependencies
     SDF_API
     std::set<std::string> GetCompositionAssetDependencies() const;
 
@@ -603,19 +697,23 @@ public:
     bool HasField(const SdfPath& path, const TfToken &name, 
         T* value) const
     {
-        if (!value) {
-            return HasField(path, name, static_cast<VtValue *>(NULL));
-        }
-
-        SdfAbstractDataTypedValue<T> outValue(value);
-        const bool hasValue = HasField(
-            path, name, static_cast<SdfAbstractDataValue *>(&outValue));
-
-        if (std::is_same<T, SdfValueBlock>::value) {
-            return hasValue && outValue.isValueBlock;
-        }
+        return _HasTypedField(path, name, value, /* useFallback = */ true);
+    }
 
-        return hasValue && (!outValue.isValueBlock);
+    /// Reads the value of \p name on the spec at \p path directly from the
+    /// layer's data into \p value, without creating spec handles or an
+    /// intermediate VtValue.  Returns true if the field is authored with a
+    /// value of type \p T, false otherwise.
+    ///
+    /// Unlike HasField(), this does not consult the schema for the fallback
+    /// value of unauthored required fields.  A value block is only returned
+    /// if \p T is SdfValueBlock.  If \p value is null, returns whether the
+    /// field is authored, as HasField() does.  This is safe to call
+    /// concurrently from multiple threads while no thread modifies the layer.
+    template <class T>
+    bool GetFieldRaw(const SdfPath& path, const TfToken &name, T* value) const
+    {
+        return _HasTypedField(path, name, value, /* useFallback = */ false);
     }
 
     /// Return the type of the value for \p name on spec \p path.  If no such
@@ -760,6 +858,33 @@ public:
     SDF_API
     void Traverse(const SdfPath& path, const TraversalFunction& func);
 
+    /// Callback function for ParallelTraverse. This callback will be invoked
+    /// concurrently from multiple threads with the path of each spec that is
+    /// visited, and must be thread-safe. Returning false prunes the traversal
+    /// of the namespace descendants of that spec.
+    /// \sa ParallelTraverse
+    using ParallelTraversalFunction = std::function<bool(const SdfPath&)>;
+
+    /// Perform a parallel traversal of the scene description hierarchy rooted
+    /// at \a path, calling \a func on each spec that it finds.
+    ///
+    /// Unlike Traverse, specs are visited in pre-order: \a func is invoked
+    /// on a spec before any of its descendants, which lets \a func prune the
+    /// subtree below that spec by returning false. No ordering is guaranteed
+    /// between siblings or between specs in different subtrees. Children are
+    /// discovered by reading only the children fields relevant to each spec's
+    /// type rather than listing all of its fields.
+    ///
+    /// If \a cancel is not null, the traversal stops visiting new specs as
+    /// soon as it observes \a cancel set to true. Returns false if the
+    /// traversal was cancelled, true otherwise.
+    ///
+    /// The layer must not be modified while the traversal is running.
+    SDF_API
+    bool ParallelTraverse(const SdfPath& path,
+                          const ParallelTraversalFunction& func,
+                          const std::atomic<bool> *cancel = nullptr) const;
+
     /// @}
 
     /// \name Metadata
@@ -1554,6 +1679,43 @@ public:
     SDF_API
     bool IsDirty() const;
 
+    /// A round of change processing recorded in the change journal: the
+    /// serial number the round was sent with (see
+    /// SdfNotice::BaseLayersDidChange::GetSerialNumber()) and the changes
+    /// made to this layer in that round.
+    using ChangeJournalRound = std::pair<size_t, SdfChangeList>;
+
+    /// Keep a journal of the changes made to this layer, so that clients
+    /// which missed change notices can catch up with
+    /// GetJournaledChangesSince().  The journal keeps the most recent rounds
+    /// whose change lists hold at most \p maxEntries entries in total,
+    /// discarding older rounds as needed.  Passing 0, the default, disables
+    /// the journal and discards its contents.  Rounds are only recorded
+    /// from the time the journal is enabled.
+    ///
+    /// The limit is a count of change list entries, not a memory budget.
+    /// Entries hold copies of the values they capture, such as the old and
+    /// new values of changed info fields, so the memory a journal holds
+    /// depends on the values authored as well as on \p maxEntries.
+    SDF_API
+    void SetChangeJournalLimit(size_t maxEntries);
+
+    /// Returns the limit on the number of entries held in this layer's
+    /// change journal, or 0 if the journal is disabled.
+    SDF_API
+    size_t GetChangeJournalLimit() const;
+
+    /// Append the journaled rounds of changes to this layer that were sent
+    /// after the round with serial number \p serialNumber to \p rounds, in
+    /// the order they were sent.  Returns false if the journal is disabled
+    /// or no longer holds all of those rounds, in which case clients must
+    /// rebuild their state from the layer's contents.
+    ///
+    /// This may be called concurrently with edits to this layer.
+    SDF_API
+    bool GetJournaledChangesSince(
+        size_t serialNumber, std::vector<ChangeJournalRound> *rounds) const;
+
     /// @}
 
     /// \name Time-sample API
@@ -1719,6 +1881,15 @@ private:
     // IsDirty() state would change again...
     bool _UpdateLastDirtinessState() const;
 
+    // Discard the saved text for the root prim that \p path is in or
+    // beneath, if any.  The change manager calls this for every edit.
+    void _InvalidateRootPrimText(const SdfPath &path) {
+        if (_rootPrimTextCache) {
+            _EraseRootPrimText(path);
+        }
+    }
+    void _EraseRootPrimText(const SdfPath &path);
+
     // Returns a handle to the spec at the given path if it exists and matches
     // type T.
     template <class T>
@@ -1757,6 +1928,14 @@ private:
         const _FindOrOpenLayerInfo& info,
         bool metadataOnly);
 
+    // Read the contents of \p layer, which has just been created and added
+    // to the registry by _OpenLayerAndUnlockRegistry or FindOrOpenMany, and
+    // finish its initialization.  The registry lock must not be held.
+    static SdfLayerRefPtr _ReadNewlyRegisteredLayer(
+        SdfLayerRefPtr layer,
+        const _FindOrOpenLayerInfo& info,
+        bool metadataOnly);
+
     // Helper function for finding a layer with \p identifier and \p args.
     // \p lock must be unlocked initially and will be locked by this
     // function when needed. See docs for \p retryAsWriter argument on
@@ -1807,8 +1986,17 @@ private:
     /// Performs a depth first search of the namespace hierarchy, beginning at
     /// \p prim, removing prims that do not affect the scene. The return value 
     /// indicates whether the prim passed in is now inert as a result of this 
-    /// call, and can itself be removed.
-    bool _RemoveInertDFS(SdfPrimSpecHandle prim);
+    /// call, and can itself be removed.  If \p inertPrims is given, it must
+    /// hold the result of _FindInertPrims for \p prim or one of its
+    /// ancestors; subtrees without inert prims are then skipped.
+    bool _RemoveInertDFS(SdfPrimSpecHandle prim,
+                         const SdfPathVector *inertPrims = nullptr);
+
+    /// Returns the sorted paths of the prim and variant specs at and below
+    /// \p path that are inert by themselves, as determined by _IsInert with
+    /// children fields considered.  Descendants of inert specs are not
+    /// examined.  Subtrees are examined in parallel.
+    SdfPathVector _FindInertPrims(const SdfPath &path) const;
 
     /// If \p prim is inert (has no affect on the scene), removes prim, then 
     /// prunes inert parent prims back to the root.
@@ -1827,9 +2015,39 @@ private:
         const std::string &oldLayerPath,
         const std::string &newLayerPath);
 
+    // Record the changes made to this layer in the round of change
+    // processing with \p serialNumber in the change journal, if enabled.
+    void _RecordChangesInJournal(size_t serialNumber,
+                                 const SdfChangeList &changes);
+
     // Set the clean state to the current state.
     void _MarkCurrentStateAsClean() const;
 
+    // Implements HasField<T>() and, if \p useFallback is false,
+    // GetFieldRaw<T>(), which reads only this layer's data.
+    template <class T>
+    bool _HasTypedField(const SdfPath& path, const TfToken &name, T* value,
+                        bool useFallback) const
+    {
+        if (!value) {
+            return useFallback ?
+                HasField(path, name, static_cast<VtValue *>(NULL)) :
+                _data->Has(path, name, static_cast<VtValue *>(NULL));
+        }
+
+        SdfAbstractDataTypedValue<T> outValue(value);
+        SdfAbstractDataValue *const abstractValue = &outValue;
+        const bool hasValue = useFallback ?
+            HasField(path, name, abstractValue) :
+            _data->Has(path, name, abstractValue);
+
+        if (std::is_same<T, SdfValueBlock>::value) {
+            return hasValue && outValue.isValueBlock;
+        }
+
+        return hasValue && (!outValue.isValueBlock);
+    }
+
     // Return the field definition for \p fieldName if \p fieldName is a
     // required field for the spec type identified by \p path.
     inline SdfSchema::FieldDefinition const *
@@ -2076,6 +2294,18 @@ private:
     // Layer hints as of the most recent save operation.
     mutable SdfLayerHints _hints;
 
+    // Text of the root prims as last saved by the usda file format, if
+    // incremental saves are enabled.  See Sdf_RootPrimTextCache.
+    mutable std::unique_ptr<Sdf_RootPrimTextCache> _rootPrimTextCache;
+
+    // Journal of the recent rounds of changes to this layer, if enabled.
+    // _hasChangeJournal is set while it is, so that change processing need
+    // not take the mutex for layers without one.
+    struct _ChangeJournal;
+    mutable std::mutex _changeJournalMutex;
+    std::unique_ptr<_ChangeJournal> _changeJournal;
+    std::atomic<bool> _hasChangeJournal { false };
+
     // Allow access to _ValidateAuthoring() and _IsInert().
     friend class SdfSpec;
     friend class SdfPropertySpec;
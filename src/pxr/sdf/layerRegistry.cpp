@@ -103,6 +103,90 @@ _TryToRemove(
     return false;
 }
 
+static std::pair<SdfLayerHandle, bool>
+_Emplace(const std::string& key, const SdfLayerHandle& layer,
+         std::unordered_map<std::string, SdfLayerHandle, TfHash>* map) {
+    const auto insertion = map->emplace(key, layer);
+    return std::make_pair(insertion.first->second, insertion.second);
+}
+
+static std::pair<SdfLayerHandle, bool>
+_Emplace(const std::string& key, const SdfLayerHandle& layer,
+         std::unordered_multimap<std::string, SdfLayerHandle, TfHash>* map) {
+    map->emplace(key, layer);
+    return std::make_pair(layer, true);
+}
+
+// Acquire \p mutex, counting acquisitions that had to wait for another
+// thread.
+static void
+_AcquireShardLock(tbb::spin_rw_mutex::scoped_lock* lock,
+                  tbb::spin_rw_mutex& mutex, bool write)
+{
+    if (!lock->try_acquire(mutex, write)) {
+        TRACE_COUNTER_DELTA("Sdf_LayerRegistry shard lock contention", 1);
+        lock->acquire(mutex, write);
+    }
+}
+
+template <class Map>
+SdfLayerHandle
+Sdf_LayerRegistry::_ShardedIndex<Map>::Find(
+    const std::string& key, SdfLayerRefPtr* acquired) const
+{
+    const _Shard& shard = _GetShard(key);
+    tbb::spin_rw_mutex::scoped_lock lock;
+    _AcquireShardLock(&lock, shard.mutex, /*write=*/false);
+
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
+        return SdfLayerHandle();
+    }
+    if (acquired) {
+        // The layer's destructor must take this shard's write lock to erase
+        // its entry, so the layer's TfRefBase cannot be destroyed while we
+        // hold the read lock.
+        *acquired = TfCreateRefPtrFromProtectedWeakPtr(it->second);
+    }
+    return it->second;
+}
+
+template <class Map>
+std::pair<SdfLayerHandle, bool>
+Sdf_LayerRegistry::_ShardedIndex<Map>::Emplace(
+    const std::string& key, const SdfLayerHandle& layer)
+{
+    _Shard& shard = _GetShard(key);
+    tbb::spin_rw_mutex::scoped_lock lock;
+    _AcquireShardLock(&lock, shard.mutex, /*write=*/true);
+    return _Emplace(key, layer, &shard.map);
+}
+
+template <class Map>
+bool
+Sdf_LayerRegistry::_ShardedIndex<Map>::TryToRemove(
+    const std::string& key, const SdfLayerHandle& layer)
+{
+    _Shard& shard = _GetShard(key);
+    tbb::spin_rw_mutex::scoped_lock lock;
+    _AcquireShardLock(&lock, shard.mutex, /*write=*/true);
+    return _TryToRemove(key, layer, &shard.map);
+}
+
+template <class Map>
+template <class Fn>
+void
+Sdf_LayerRegistry::_ShardedIndex<Map>::ForEach(const Fn& fn) const
+{
+    for (const _Shard& shard : _shards) {
+        tbb::spin_rw_mutex::scoped_lock lock;
+        _AcquireShardLock(&lock, shard.mutex, /*write=*/false);
+        for (const auto& entry : shard.map) {
+            fn(entry.first, entry.second);
+        }
+    }
+}
+
 void
 Sdf_LayerRegistry::_Layers::Update(const SdfLayerHandle& layer,
                                    const Sdf_AssetInfo& oldInfo,
@@ -110,12 +194,12 @@ Sdf_LayerRegistry::_Layers::Update(const SdfLayerHandle& layer,
     const auto oldAliases = _AssetInfoToAliases(oldInfo);
     auto newAliases = _AssetInfoToAliases(newInfo);
     if (oldAliases.realPath != newAliases.realPath) {
-        if (_TryToRemove(oldAliases.realPath, layer, &_byRealPath)) {
+        if (_byRealPath.TryToRemove(oldAliases.realPath, layer)) {
             TF_DEBUG(SDF_LAYER).Msg("Removed realPath '%s' for update.\n",
                                     oldAliases.realPath.c_str());
         }
         if (!newAliases.realPath.empty()) {
-            if (const auto insertion = _byRealPath.emplace(
+            if (const auto insertion = _byRealPath.Emplace(
                     newAliases.realPath, layer);
                 insertion.second) {
                 TF_DEBUG(SDF_LAYER).Msg("Updated realPath '%s'.\n",
@@ -139,27 +223,26 @@ Sdf_LayerRegistry::_Layers::Update(const SdfLayerHandle& layer,
         }
     }
     if (oldAliases.repositoryPath != newAliases.repositoryPath) {
-        if (_TryToRemove(oldAliases.repositoryPath, layer,
-                         &_byRepositoryPath)) {
+        if (_byRepositoryPath.TryToRemove(oldAliases.repositoryPath,
+                                          layer)) {
             TF_DEBUG(SDF_LAYER).Msg("Removed repositoryPath '%s' for "
                                     "update.\n",
                                     oldAliases.repositoryPath.c_str());
         }
         if (!newAliases.repositoryPath.empty()) {
-            _byRepositoryPath.emplace(newAliases.repositoryPath, layer);
+            _byRepositoryPath.Emplace(newAliases.repositoryPath, layer);
             TF_DEBUG(SDF_LAYER).Msg("Updated repositoryPath '%s'.\n",
                                     newAliases.repositoryPath.c_str());
         }
     }
     if (oldAliases.identifier != newAliases.identifier) {
-        if (_TryToRemove(oldAliases.identifier, layer,
-                         &_byIdentifier)) {
+        if (_byIdentifier.TryToRemove(oldAliases.identifier, layer)) {
             TF_DEBUG(SDF_LAYER).Msg("Removed identifier '%s' for "
                                     "update.\n",
                                     oldAliases.identifier.c_str());
         }
         if (!newAliases.identifier.empty()) {
-            _byIdentifier.emplace(newAliases.identifier, layer);
+            _byIdentifier.Emplace(newAliases.identifier, layer);
             TF_DEBUG(SDF_LAYER).Msg("Updated identifier '%s'.\n",
                                     newAliases.identifier.c_str());
         }
@@ -170,22 +253,22 @@ std::pair<SdfLayerHandle, bool>
 Sdf_LayerRegistry::_Layers::Insert(const SdfLayerHandle& layer,
                                    const Sdf_AssetInfo& assetInfo) {
     const auto aliases = _AssetInfoToAliases(assetInfo);
-    if (const auto it = _byRealPath.find(aliases.realPath);
-        it != std::end(_byRealPath)) {
-        return std::make_pair(it->second, false);
+    if (const SdfLayerHandle existing =
+            _byRealPath.Find(aliases.realPath, nullptr)) {
+        return std::make_pair(existing, false);
     }
     if (!aliases.realPath.empty()) {
-        TF_VERIFY(_byRealPath.emplace(aliases.realPath, layer).second);
+        TF_VERIFY(_byRealPath.Emplace(aliases.realPath, layer).second);
         TF_DEBUG(SDF_LAYER).Msg("Inserted realPath '%s' into registry\n",
                                 aliases.realPath.c_str());
     }
     if (!aliases.repositoryPath.empty()) {
-        _byRepositoryPath.emplace(aliases.repositoryPath, layer);
+        _byRepositoryPath.Emplace(aliases.repositoryPath, layer);
         TF_DEBUG(SDF_LAYER).Msg("Inserted repositoryPath '%s' into registry\n",
                                 aliases.repositoryPath.c_str());
     }
     if (!aliases.identifier.empty()) {
-        _byIdentifier.emplace(aliases.identifier, layer);
+        _byIdentifier.Emplace(aliases.identifier, layer);
         TF_DEBUG(SDF_LAYER).Msg("Inserted identifier '%s' into registry\n",
                                 aliases.identifier.c_str());
     }
@@ -205,20 +288,18 @@ Sdf_LayerRegistry::_Layers::Erase(const SdfLayerHandle& layer,
     // a real path collisions due to asset resolver context updates
     // and may lead to an early eviction of a layer from the registry.
     bool erased = false;
-    if (_TryToRemove(aliases.realPath, layer, &_byRealPath)) {
+    if (_byRealPath.TryToRemove(aliases.realPath, layer)) {
         erased = true;
         TF_DEBUG(SDF_LAYER).Msg("Erased realPath '%s' from registry.\n",
                                 aliases.realPath.c_str());
     }
-    if (_TryToRemove(aliases.repositoryPath, layer,
-                     &_byRepositoryPath)) {
+    if (_byRepositoryPath.TryToRemove(aliases.repositoryPath, layer)) {
         erased = true;
         TF_DEBUG(SDF_LAYER).Msg(
             "Erased repositoryPath '%s' from registry.\n",
             aliases.repositoryPath.c_str());
     }
-    if (_TryToRemove(aliases.identifier, layer,
-                     &_byIdentifier)) {
+    if (_byIdentifier.TryToRemove(aliases.identifier, layer)) {
         erased = true;
         TF_DEBUG(SDF_LAYER).Msg(
             "Erased identifier '%s' from registry.\n",
@@ -294,13 +375,32 @@ SdfLayerHandle
 Sdf_LayerRegistry::Find(
     const string &inputLayerPath,
     const string &resolvedPath) const
+{
+    return _Find(inputLayerPath, resolvedPath, /*acquired=*/nullptr);
+}
+
+SdfLayerRefPtr
+Sdf_LayerRegistry::FindAndAcquire(
+    const string &inputLayerPath,
+    const string &resolvedPath) const
+{
+    SdfLayerRefPtr layer;
+    _Find(inputLayerPath, resolvedPath, &layer);
+    return layer;
+}
+
+SdfLayerHandle
+Sdf_LayerRegistry::_Find(
+    const string &inputLayerPath,
+    const string &resolvedPath,
+    SdfLayerRefPtr *acquired) const
 {
     TRACE_FUNCTION();
 
     SdfLayerHandle foundLayer;
 
     if (Sdf_IsAnonLayerIdentifier(inputLayerPath)) {
-        foundLayer = _FindByIdentifier(inputLayerPath);
+        foundLayer = _FindByIdentifier(inputLayerPath, acquired);
     } else {
         ArResolver& resolver = ArGetResolver();
 
@@ -312,7 +412,7 @@ Sdf_LayerRegistry::Find(
         string assetPath, args;
         Sdf_SplitIdentifier(inputLayerPath, &assetPath, &args);
         if (!resolver.IsContextDependentPath(assetPath)) {
-            foundLayer = _FindByIdentifier(layerPath);
+            foundLayer = _FindByIdentifier(layerPath, acquired);
         }
 
         // If the layer path is in repository form and we haven't yet
@@ -320,14 +420,14 @@ Sdf_LayerRegistry::Find(
         // layer by repository path.
         const bool isRepositoryPath = resolver.IsRepositoryPath(assetPath);
         if (!foundLayer && isRepositoryPath) {
-            foundLayer = _FindByRepositoryPath(layerPath);
+            foundLayer = _FindByRepositoryPath(layerPath, acquired);
         }
 
         // If the layer has not yet been found, this may be some other
         // form of path that requires path resolution and lookup in the
         // real path index in order to locate.
         if (!foundLayer) {
-            foundLayer = _FindByRealPath(layerPath, resolvedPath);
+            foundLayer = _FindByRealPath(layerPath, resolvedPath, acquired);
         }
     }
 
@@ -341,16 +441,13 @@ Sdf_LayerRegistry::Find(
 
 SdfLayerHandle
 Sdf_LayerRegistry::_FindByIdentifier(
-    const string& layerPath) const
+    const string& layerPath,
+    SdfLayerRefPtr *acquired) const
 {
     TRACE_FUNCTION();
 
-    SdfLayerHandle foundLayer;
-    const auto& byIdentifier = _layers.ByIdentifier();
-    const auto identifierIt = byIdentifier.find(layerPath);
-    if (identifierIt != byIdentifier.end()) {
-        foundLayer = identifierIt->second;
-    }
+    const SdfLayerHandle foundLayer =
+        _layers.ByIdentifier().Find(layerPath, acquired);
 
     TF_DEBUG(SDF_LAYER).Msg(
         "Sdf_LayerRegistry::_FindByIdentifier('%s') => %s\n",
@@ -362,7 +459,8 @@ Sdf_LayerRegistry::_FindByIdentifier(
 
 SdfLayerHandle
 Sdf_LayerRegistry::_FindByRepositoryPath(
-    const string& layerPath) const
+    const string& layerPath,
+    SdfLayerRefPtr *acquired) const
 {
     TRACE_FUNCTION();
 
@@ -371,11 +469,7 @@ Sdf_LayerRegistry::_FindByRepositoryPath(
     if (layerPath.empty())
         return foundLayer;
 
-    const auto& byRepoPath = _layers.ByRepositoryPath();
-    const auto repoPathIt = byRepoPath.find(layerPath);
-    if (repoPathIt != byRepoPath.end()) {
-        foundLayer = repoPathIt->second;
-    }
+    foundLayer = _layers.ByRepositoryPath().Find(layerPath, acquired);
 
     TF_DEBUG(SDF_LAYER).Msg(
         "Sdf_LayerRegistry::_FindByRepositoryPath('%s') => %s\n",
@@ -388,7 +482,8 @@ Sdf_LayerRegistry::_FindByRepositoryPath(
 SdfLayerHandle
 Sdf_LayerRegistry::_FindByRealPath(
     const string& layerPath,
-    const string& resolvedPath) const
+    const string& resolvedPath,
+    SdfLayerRefPtr *acquired) const
 {
     TRACE_FUNCTION();
 
@@ -426,11 +521,7 @@ Sdf_LayerRegistry::_FindByRealPath(
     }
     searchPath = Sdf_CreateIdentifier(searchPath, arguments);
 
-    const auto& byRealPath = _layers.ByRealPath();
-    const auto realPathIt = byRealPath.find(searchPath);
-    if (realPathIt != byRealPath.end()) {
-        foundLayer = realPathIt->second;
-    }
+    foundLayer = _layers.ByRealPath().Find(searchPath, acquired);
 
     TF_DEBUG(SDF_LAYER).Msg(
         "Sdf_LayerRegistry::_FindByRealPath('%s') => %s\n",
@@ -445,12 +536,12 @@ Sdf_LayerRegistry::GetLayers() const
 {
     SdfLayerHandleSet layers;
 
-    for (const auto& entry : _layers.ByIdentifier()) {
-        SdfLayerHandle layer = entry.second;
-        if (TF_VERIFY(layer, "Found expired layer in registry")) {
-            layers.insert(layer);
-        }
-    }
+    _layers.ByIdentifier().ForEach(
+        [&layers](const string&, const SdfLayerHandle& layer) {
+            if (TF_VERIFY(layer, "Found expired layer in registry")) {
+                layers.insert(layer);
+            }
+        });
 
     return layers;
 }
@@ -15,6 +15,9 @@
 #include "pxr/sdf/declareHandles.h"
 #include <pxr/tf/hash.h>
 
+#include <tbb/spin_rw_mutex.h>
+
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <iosfwd>
@@ -30,6 +33,13 @@ SDF_DECLARE_HANDLES(SdfLayer);
 /// is inserted into the layer registry. This allows SdfLayer::Find/FindOrOpen
 /// to locate loaded layers.
 ///
+/// The identifier, repository path and real path indices are each split
+/// into shards guarded by their own reader-writer lock. Insert, Update and
+/// Erase must be serialized by the caller, but lookups may run concurrently
+/// with them and with each other, contending only on the shard a key hashes
+/// to. Waits on a shard lock are reported through the
+/// "Sdf_LayerRegistry shard lock contention" trace counter.
+///
 class Sdf_LayerRegistry
 {
     Sdf_LayerRegistry(const Sdf_LayerRegistry&) = delete;
@@ -57,17 +67,36 @@ public:
     SdfLayerHandle Find(const std::string &layerPath,
                         const std::string &resolvedPath=std::string()) const;
 
+    /// Like Find, but also tries to take an ownership stake in the found
+    /// layer while holding the lock of the shard it was found in. A layer's
+    /// destructor must acquire the same lock to remove itself from the
+    /// registry, so unlike Find this does not require the caller to
+    /// serialize against layer destruction. Returns null if no layer is
+    /// found or if the found layer is expiring.
+    SdfLayerRefPtr FindAndAcquire(
+        const std::string &layerPath,
+        const std::string &resolvedPath=std::string()) const;
+
     /// Returns all valid layers held in the registry as a set.
     SdfLayerHandleSet GetLayers() const;
 
 private:
+    // Implements Find and FindAndAcquire. If \p acquired is not null, it is
+    // set to an ownership stake in the found layer, taken while the index
+    // shard holding it is locked.
+    SdfLayerHandle _Find(const std::string &layerPath,
+                         const std::string &resolvedPath,
+                         SdfLayerRefPtr *acquired) const;
+
     // Returns a layer from the registry, consulting the by_identifier index
     // with the \p layerPath as provided.
-    SdfLayerHandle _FindByIdentifier(const std::string& layerPath) const;
+    SdfLayerHandle _FindByIdentifier(const std::string& layerPath,
+                                     SdfLayerRefPtr *acquired) const;
 
     // Returns a layer from the registry, consulting the by_repository_path
     // index with the \p layerPath as provided.
-    SdfLayerHandle _FindByRepositoryPath(const std::string& layerPath) const;
+    SdfLayerHandle _FindByRepositoryPath(const std::string& layerPath,
+                                         SdfLayerRefPtr *acquired) const;
     
     // Returns a layer from the registry, consulting the by_real_path index.  If
     // \p layerPath is an absolute file system path, the index is searched using
@@ -75,20 +104,63 @@ private:
     // path is used to search the index.
     SdfLayerHandle _FindByRealPath(
         const std::string& layerPath,
-        const std::string& resolvedPath=std::string()) const;
+        const std::string& resolvedPath,
+        SdfLayerRefPtr *acquired) const;
+
+    // A sharded map from one of a layer's string representations (realPath,
+    // identifier or repositoryPath) to the layer.  Each shard is guarded by
+    // its own lock; the map itself only locks around individual operations.
+    template <class Map>
+    class _ShardedIndex final {
+    public:
+        static constexpr size_t NumShards = 16;
+
+        // Returns the layer stored for \p key, or a null handle.  If
+        // \p acquired is not null, it is set to an ownership stake in the
+        // returned layer taken while the shard is locked.
+        SdfLayerHandle Find(const std::string &key,
+                            SdfLayerRefPtr *acquired) const;
+
+        // Inserts an entry, returning false and the existing layer instead
+        // if the map is unique and \p key is already present.
+        std::pair<SdfLayerHandle, bool> Emplace(const std::string &key,
+                                                const SdfLayerHandle &layer);
+
+        // Removes the entry for \p key if it maps to \p layer.
+        bool TryToRemove(const std::string &key, const SdfLayerHandle &layer);
+
+        // Invokes \p fn with every (key, layer) entry, one shard at a time.
+        template <class Fn>
+        void ForEach(const Fn &fn) const;
+
+    private:
+        struct _Shard {
+            mutable tbb::spin_rw_mutex mutex;
+            Map map;
+        };
+
+        _Shard &_GetShard(const std::string &key) {
+            return _shards[TfHash()(key) % NumShards];
+        }
+        const _Shard &_GetShard(const std::string &key) const {
+            return _shards[TfHash()(key) % NumShards];
+        }
+
+        std::array<_Shard, NumShards> _shards;
+    };
 
-    // A wrapper around a set of unordered_maps that maps layers
+    // A wrapper around a set of sharded indices that maps layers
     // bidirectionally to their various string representations (realPath,
     // identifier, and repositoryPath)
     class _Layers final {
     public:
         _Layers() = default;
-        using LayersByRealPath =
-            std::unordered_map<std::string, SdfLayerHandle, TfHash>;
-        using LayersByIdentifier =
-            std::unordered_multimap<std::string, SdfLayerHandle, TfHash>;
-        using LayersByRepositoryPath =
-            std::unordered_multimap<std::string, SdfLayerHandle, TfHash>;
+        using LayersByRealPath = _ShardedIndex<
+            std::unordered_map<std::string, SdfLayerHandle, TfHash>>;
+        using LayersByIdentifier = _ShardedIndex<
+            std::unordered_multimap<std::string, SdfLayerHandle, TfHash>>;
+        using LayersByRepositoryPath = _ShardedIndex<
+            std::unordered_multimap<std::string, SdfLayerHandle, TfHash>>;
 
         const LayersByRealPath& ByRealPath() const { return _byRealPath; }
         const LayersByIdentifier& ByIdentifier() const {
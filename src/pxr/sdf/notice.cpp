@@ -20,6 +20,8 @@ TF_REGISTRY_FUNCTION(TfType)
                     TfType::Bases< SdfNotice::Base > >();
     TfType::Define< SdfNotice::LayersDidChangeSentPerLayer,
                     TfType::Bases< SdfNotice::Base > >();
+    TfType::Define< SdfNotice::LayersDidChangeSentPerLayerConcurrently,
+                    TfType::Bases< SdfNotice::Base > >();
     TfType::Define< SdfNotice::LayerInfoDidChange,
                     TfType::Bases< SdfNotice::Base > >();
     TfType::Define< SdfNotice::LayerIdentifierDidChange,
@@ -59,6 +61,8 @@ SdfNotice::LayerIdentifierDidChange::LayerIdentifierDidChange(
 SdfNotice::Base::~Base() { }
 SdfNotice::LayersDidChange::~LayersDidChange() { }
 SdfNotice::LayersDidChangeSentPerLayer::~LayersDidChangeSentPerLayer() { }
+SdfNotice::LayersDidChangeSentPerLayerConcurrently::
+    ~LayersDidChangeSentPerLayerConcurrently() { }
 SdfNotice::LayerInfoDidChange::~LayerInfoDidChange() { }
 SdfNotice::LayerIdentifierDidChange::~LayerIdentifierDidChange() { }
 SdfNotice::LayerDidReplaceContent::~LayerDidReplaceContent() { }
@@ -100,6 +100,31 @@ public:
         SDF_API virtual ~LayersDidChangeSentPerLayer();
     };
 
+    /// \class LayersDidChangeSentPerLayerConcurrently
+    ///
+    /// Same as LayersDidChangeSentPerLayer, but may be sent for all changed
+    /// layers concurrently.  Registering for this notice declares that the
+    /// listener is thread-safe: it may be invoked for several layers at once,
+    /// from threads other than the one that closed the change block.  These
+    /// notices are only sent when the SDF_CHANGE_MANAGER_CONCURRENT_NOTICES
+    /// environment setting is enabled.  They are sent in parallel when a
+    /// round changes enough layers, and serially otherwise.
+    ///
+    /// Within a round of change processing, these notices are sent after the
+    /// global LayersDidChange notice and after every
+    /// LayersDidChangeSentPerLayer notice.  There is no ordering between the
+    /// notices for different layers, but all of them have been delivered
+    /// before the round completes, so rounds never overlap for a listener.
+    ///
+    class LayersDidChangeSentPerLayerConcurrently
+        : public Base, public BaseLayersDidChange {
+    public:
+        LayersDidChangeSentPerLayerConcurrently(
+            const SdfLayerChangeListVec &changeVec, size_t serialNumber)
+            : BaseLayersDidChange(changeVec, serialNumber) {}
+        SDF_API virtual ~LayersDidChangeSentPerLayerConcurrently();
+    };
+
     /// \class LayersDidChange
     ///
     /// Global notice sent to indicate that layer contents have changed.
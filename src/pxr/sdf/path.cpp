@@ -22,8 +22,11 @@
 #include <pxr/tf/type.h>
 
 #include <pxr/trace/trace.h>
+#include <pxr/work/loops.h>
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <ostream>
 
 using std::pair;
@@ -1130,6 +1133,129 @@ TF_MAKE_STATIC_DATA(const string, theExpressionElementString) {
         SdfPathTokens->expressionIndicator.GetString();
 }
 
+SdfPathVector
+SdfPath::BuildTree(const SdfPath &root,
+                   const std::vector<size_t> &parentIndexes,
+                   const TfTokenVector &names,
+                   const std::vector<bool> &isProperty)
+{
+    TRACE_FUNCTION();
+
+    const size_t numPaths = names.size();
+    if (parentIndexes.size() != numPaths ||
+        (!isProperty.empty() && isProperty.size() != numPaths)) {
+        TF_CODING_ERROR("BuildTree requires one parent index and at most one "
+                        "property flag per name");
+        return SdfPathVector();
+    }
+
+    // Bucket the elements by their depth below the root, so that each level
+    // can be created in bulk once its parents exist.
+    vector<uint32_t> depths(numPaths);
+    vector<size_t> levelStarts(1, 0);
+    for (size_t i = 0; i != numPaths; ++i) {
+        const size_t parentIndex = parentIndexes[i];
+        uint32_t depth = 0;
+        if (parentIndex != TreeRootIndex) {
+            if (ARCH_UNLIKELY(parentIndex >= i)) {
+                TF_CODING_ERROR("Parent index %zu of element %zu does not "
+                                "precede it", parentIndex, i);
+                return SdfPathVector();
+            }
+            depth = depths[parentIndex] + 1;
+        }
+        depths[i] = depth;
+        if (depth + 2 > levelStarts.size()) {
+            levelStarts.resize(depth + 2, 0);
+        }
+        ++levelStarts[depth + 1];
+    }
+    for (size_t level = 1; level != levelStarts.size(); ++level) {
+        levelStarts[level] += levelStarts[level - 1];
+    }
+    vector<size_t> order(numPaths);
+    {
+        vector<size_t> cursors(levelStarts.begin(), levelStarts.end() - 1);
+        for (size_t i = 0; i != numPaths; ++i) {
+            order[cursors[depths[i]]++] = i;
+        }
+    }
+
+    SdfPathVector result(numPaths);
+
+    vector<size_t> primIndexes, propIndexes;
+    vector<Sdf_PathNode const *> primParents;
+    vector<TfToken const *> primNames, propNames;
+    vector<Sdf_PathPrimNodeHandle> primNodes;
+    vector<Sdf_PathPropNodeHandle> propNodes;
+
+    for (size_t level = 0; level + 1 != levelStarts.size(); ++level) {
+        primIndexes.clear();
+        primParents.clear();
+        primNames.clear();
+        propIndexes.clear();
+        propNames.clear();
+
+        // Elements that the bulk path cannot take are appended one by one,
+        // which also issues the usual diagnostics for invalid ones.
+        for (size_t j = levelStarts[level]; j != levelStarts[level + 1]; ++j) {
+            const size_t i = order[j];
+            SdfPath const &parent = parentIndexes[i] == TreeRootIndex ?
+                root : result[parentIndexes[i]];
+            TfToken const &name = names[i];
+            if (!isProperty.empty() && isProperty[i]) {
+                if ((parent.IsPrimPath() ||
+                     parent.IsPrimVariantSelectionPath()) &&
+                    IsValidNamespacedIdentifier(name.GetString())) {
+                    propIndexes.push_back(i);
+                    propNames.push_back(&name);
+                }
+                else {
+                    result[i] = parent.AppendProperty(name);
+                }
+            }
+            else {
+                if ((parent.IsAbsoluteRootOrPrimPath() ||
+                     parent.IsPrimVariantSelectionPath()) &&
+                    name != SdfPathTokens->parentPathElement &&
+                    _IsValidIdentifier(name)) {
+                    primIndexes.push_back(i);
+                    primParents.push_back(parent._primPart.get());
+                    primNames.push_back(&name);
+                }
+                else {
+                    result[i] = parent.AppendChild(name);
+                }
+            }
+        }
+
+        if (!primIndexes.empty()) {
+            primNodes.resize(primIndexes.size());
+            Sdf_PathNode::FindOrCreatePrims(
+                primIndexes.size(), primParents.data(), primNames.data(),
+                primNodes.data());
+            for (size_t k = 0; k != primIndexes.size(); ++k) {
+                result[primIndexes[k]] = SdfPath(std::move(primNodes[k]));
+            }
+        }
+
+        if (!propIndexes.empty()) {
+            propNodes.resize(propIndexes.size());
+            Sdf_PathNode::FindOrCreatePrimProperties(
+                propIndexes.size(), propNames.data(), propNodes.data());
+            for (size_t k = 0; k != propIndexes.size(); ++k) {
+                const size_t i = propIndexes[k];
+                SdfPath const &parent = parentIndexes[i] == TreeRootIndex ?
+                    root : result[parentIndexes[i]];
+                result[i] = SdfPath(Sdf_PathPrimNodeHandle(parent._primPart),
+                                    std::move(propNodes[k]));
+            }
+        }
+    }
+
+    return result;
+}
+
 SdfPath
 SdfPath::AppendElementToken(const TfToken &elementTok) const
 {
@@ -2084,6 +2210,50 @@ SdfPath::IsValidPathString(const std::string &pathString,
     return Sdf_ParsePath(pathString, /*path=*/nullptr, errMsg);
 }
 
+SdfPathVector
+SdfPath::ParseMany(const std::vector<std::string> &pathStrings)
+{
+    TfAutoMallocTag2 tag("Sdf", "SdfPath::ParseMany");
+    TRACE_FUNCTION();
+
+    SdfPathVector result(pathStrings.size());
+    std::atomic<size_t> numErrors { 0 };
+    std::mutex firstErrorMutex;
+    size_t firstErrorIndex = pathStrings.size();
+    std::string firstErrorMsg;
+
+    WorkParallelForN(
+        pathStrings.size(),
+        [&](size_t begin, size_t end) {
+            std::string errMsg;
+            for (size_t i = begin; i != end; ++i) {
+                if (Sdf_ParsePath(pathStrings[i], &result[i], &errMsg)) {
+                    continue;
+                }
+                ++numErrors;
+                std::lock_guard<std::mutex> lock(firstErrorMutex);
+                if (i < firstErrorIndex) {
+                    firstErrorIndex = i;
+                    firstErrorMsg = std::move(errMsg);
+                }
+            }
+        },
+        /*grainSize=*/1024);
+
+    if (numErrors) {
+        const std::string msg = TfStringPrintf(
+            "%zu of %zu path strings could not be parsed; the first at "
+            "index %zu: %s", numErrors.load(), pathStrings.size(),
+            firstErrorIndex, firstErrorMsg.c_str());
+#ifdef PARSE_ERRORS_ARE_ERRORS
+        TF_RUNTIME_ERROR(msg);
+#else
+        TF_WARN(msg);
+#endif
+    }
+    return result;
+}
+
 // Caller ensures both absolute or both relative.  We need to crawl up the
 // longer path until both are the same length.  Then we crawl up both until we
 // find the nodes whose parents match.  Then we can compare those nodes.
@@ -744,6 +744,29 @@ public:
     /// Like AppendElementString() but take the element as a TfToken.
     SDF_API SdfPath AppendElementToken(const TfToken &elementTok) const;
 
+    /// Parent index that BuildTree() treats as naming its \p root.
+    static constexpr size_t TreeRootIndex = static_cast<size_t>(-1);
+
+    /// Builds a tree of paths in one pass, returning one path per name.
+    ///
+    /// The parent of result element \c i is \p root if
+    /// \p parentIndexes[i] is TreeRootIndex, and otherwise result element
+    /// \p parentIndexes[i], which must be less than \c i.  Element \c i
+    /// is the property \p names[i] of its parent if \p isProperty is
+    /// non-empty and \p isProperty[i] is true, and the child prim
+    /// \p names[i] of its parent otherwise.
+    ///
+    /// The result is the same as calling AppendChild() or AppendProperty()
+    /// for every element, including the diagnostics and empty paths for
+    /// elements that cannot be appended.  The path nodes for each level of
+    /// the tree are created in bulk, taking each internal node table lock
+    /// once per level instead of once per path.
+    SDF_API static SdfPathVector
+    BuildTree(const SdfPath &root,
+              const std::vector<size_t> &parentIndexes,
+              const TfTokenVector &names,
+              const std::vector<bool> &isProperty = std::vector<bool>());
+
     /// Returns a path with all occurrences of the prefix path
     /// \p oldPrefix replaced with the prefix path \p newPrefix.
     ///
@@ -889,6 +912,14 @@ public:
     static bool IsValidPathString(const std::string &pathString,
                                   std::string *errMsg = 0);
 
+    /// Parse each of \p pathStrings as the \a SdfPath constructor would, and
+    /// return the paths in the same order.  Strings that are not valid paths
+    /// produce the empty path; rather than a warning per string, a single
+    /// warning reports how many failed and the first failure.  Large inputs
+    /// are parsed in parallel.
+    SDF_API
+    static SdfPathVector ParseMany(const std::vector<std::string> &pathStrings);
+
     /// @}
 
     /// \name Operators
@@ -1406,6 +1437,42 @@ SdfPathFindLongestStrictPrefix(
                                 TfGet<0>());
 }
 
+/// \struct SdfPathPoolStats
+///
+/// Memory statistics for the pools that hold path nodes, summed over the prim
+/// and property node pools.  See SdfPathGetPoolStats().
+struct SdfPathPoolStats
+{
+    /// Nodes handed out to threads and not on a shared free list.  This is an
+    /// upper bound on the number of live nodes, since it includes nodes that
+    /// threads hold on their local free lists for reuse.
+    size_t liveNodes = 0;
+    /// Nodes on the shared free lists.
+    size_t freeListNodes = 0;
+    /// Bytes of virtual address space reserved for nodes.
+    size_t reservedBytes = 0;
+    /// Bytes of memory committed for nodes and not returned to the system.
+    size_t committedBytes = 0;
+    /// Bytes returned to the system by SdfPathReleaseUnusedPoolMemory() and
+    /// not yet reused.
+    size_t releasedBytes = 0;
+};
+
+/// Return memory statistics for the path node pools.  This is intended for
+/// diagnostics; the values are gathered without synchronizing with threads
+/// creating or destroying paths.
+SDF_API
+SdfPathPoolStats
+SdfPathGetPoolStats();
+
+/// Return memory held by path node pools for nodes that are no longer in use
+/// to the system, for example after a large stage has been closed.  Memory is
+/// returned in large spans, and only for spans none of whose nodes are in use
+/// or held by other threads for reuse.  Return the number of bytes released.
+SDF_API
+size_t
+SdfPathReleaseUnusedPoolMemory();
+
 // A helper function for debugger pretty-printers, etc.  This function is *not*
 // thread-safe.  It writes to a static buffer and returns a pointer to it.
 // Subsequent calls to this function overwrite the memory written in prior
@@ -14,17 +14,18 @@
 #include <pxr/tf/hash.h>
 #include <pxr/tf/iterator.h>
 #include <pxr/tf/mallocTag.h>
-#include <pxr/tf/pxrTslRobinMap/robin_map.h>
 #include <pxr/tf/staticData.h>
 #include <pxr/tf/stl.h>
 
 #include <pxr/trace/trace.h>
 
-#include <tbb/concurrent_hash_map.h>
 #include <tbb/spin_mutex.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -51,6 +52,34 @@ struct Sdf_PathNodePrivateAccess
         return p->_refCount;
     }
 
+    // Add a reference to the node unless it has already begun dying (its
+    // count has dropped to zero).  Return true if a reference was added.
+    template <class Handle>
+    static inline bool
+    TryAddRef(Handle h) {
+        std::atomic<unsigned int> &refCount = GetRefCount(h);
+        unsigned int cur = refCount.load(std::memory_order_relaxed);
+        do {
+            if ((cur & Sdf_PathNode::RefCountMask) == 0) {
+                return false;
+            }
+        } while (!refCount.compare_exchange_weak(
+                     cur, cur + 1,
+                     std::memory_order_acquire, std::memory_order_relaxed));
+        return true;
+    }
+
+    // Return true if the node is a PathNode with the given parent and element.
+    template <class PathNode, class Handle, class ... Args>
+    static inline bool
+    Matches(Handle h, Sdf_PathNode const *parent, Args const & ... args) {
+        Sdf_PathNode const *p =
+            reinterpret_cast<Sdf_PathNode const *>(h.GetPtr());
+        return p->_nodeType == PathNode::nodeType &&
+            p->_parent.get() == parent &&
+            _ElementMatches(static_cast<PathNode const *>(p), args...);
+    }
+
     template <class T, class Pool, class ... Args>
     static inline typename Pool::Handle
     New(Sdf_PathNode const *parent, Args const & ... args) {
@@ -58,8 +87,26 @@ struct Sdf_PathNodePrivateAccess
         char *p = h.GetPtr();
         T *tp = reinterpret_cast<T *>(p);
         new (tp) T(parent, args...);
+        // Publish the node's initial reference only once it is fully
+        // constructed.  Lookups that take no lock add references with
+        // TryAddRef, which must not succeed on a node still being built in
+        // the memory of one that has died.
+        tp->_refCount.store(1, std::memory_order_release);
         return h;
     }
+
+private:
+    template <class PathNode, class Arg>
+    static inline bool
+    _ElementMatches(PathNode const *p, Arg const &arg) {
+        return p->_GetComparisonValue() == arg;
+    }
+
+    template <class PathNode>
+    static inline bool
+    _ElementMatches(PathNode const *) {
+        return true;
+    }
 };
 
 typedef Sdf_PathNodePrivateAccess Access;
@@ -67,135 +114,291 @@ typedef Sdf_PathNodePrivateAccess Access;
 namespace {
 
 template <class T=void>
-struct _ParentAnd { const Sdf_PathNode *parent; T value; };
+struct _ParentAndRef { const Sdf_PathNode *parent; T const &value; };
 
 // Allow void for 'expression' path case, which has no additional data.
-template <> struct _ParentAnd<void> { const Sdf_PathNode *parent; };
+template <> struct _ParentAndRef<void> { const Sdf_PathNode *parent; };
 
-template <class T=void>
-struct _ParentAndRef {
-    const Sdf_PathNode *parent; T const &value;
-    operator _ParentAnd<T>() const {
-        return { parent, value };
-    }
-};
+template <class PaT>
+inline size_t _OuterHash(PaT const &pat)
+{
+    return TfHash::Combine(pat.parent, pat.value);
+}
 
-// Allow void for 'expression' path case, which has no additional data.
-template <> struct _ParentAndRef<void>
+inline size_t _OuterHash(_ParentAndRef<void> const &pat)
 {
-    const Sdf_PathNode *parent;
-    operator _ParentAnd<void>() const {
-        return { parent };
-    }
+    return TfHash::Combine(pat.parent);
 };
 
+static constexpr unsigned NumNodeMaps = 128;
 
-
-template <class T>
-inline bool operator==(_ParentAnd<T> const &x, _ParentAnd<T> const &y)
-{
-    return x.parent == y.parent && x.value == y.value;
-}
-template <class T>
-inline bool operator==(_ParentAndRef<T> const &x, _ParentAndRef<T> const &y)
+// The low bits of a key's hash pick its shard, and the high 32 bits are kept
+// in the shard's slots to find its home slot and to reject most mismatches
+// without touching node memory.
+inline uint32_t _SlotTag(size_t hash)
 {
-    return x.parent == y.parent && x.value == y.value;
-}
-template <class T>
-inline bool operator==(_ParentAndRef<T> const &x, _ParentAnd<T> const &y)
-{
-    return x.parent == y.parent && x.value == y.value;
-}
-template <class T>
-inline bool operator==(_ParentAnd<T> const &x, _ParentAndRef<T> const &y)
-{
-    return x.parent == y.parent && x.value == y.value;
+    return static_cast<uint32_t>(uint64_t(hash) >> 32);
 }
 
-inline bool operator==(_ParentAnd<void> const &x, _ParentAnd<void> const &y)
-{
-    return x.parent == y.parent;
-}
-inline bool operator==(_ParentAndRef<void> const &x,
-                       _ParentAndRef<void> const &y)
-{
-    return x.parent == y.parent;
-}
-inline bool operator==(_ParentAndRef<void> const &x, _ParentAnd<void> const &y)
-{
-    return x.parent == y.parent;
-}
-inline bool operator==(_ParentAnd<void> const &x, _ParentAndRef<void> const &y)
+// An open-addressing hash table with linear probing, shared by the path node
+// and path token tables.  Slots hold values of type Slot, a pointer or an
+// integer whose zero value marks an empty slot, and GetHome()(slot) returns
+// the hash that picks a value's home slot.
+//
+// All modifications require the owner's lock.  Lookups of existing values can
+// instead probe without the lock (see FindUnlocked()).  Writers may move
+// entries while such a lookup is probing, which can only make it miss, so
+// callers fall back to a locked lookup on a miss.  Slot arrays replaced by
+// growth are kept until Clear(), since unlocked lookups may still be probing
+// them.  Since each array doubles the last, together they are smaller than
+// the current one.
+template <class Slot, class GetHome>
+class _ProbeTable
 {
-    return x.parent == y.parent;
-}
+public:
+    static constexpr size_t NotFound = ~size_t(0);
+
+    // Return the first slot in \p home's probe sequence for which \p match
+    // returns true, or an empty slot.  This takes no lock, so it may probe a
+    // slot array while it is being modified or after it has been replaced.
+    template <class Match>
+    Slot FindUnlocked(size_t home, Match const &match) const {
+        _Slots const *s = _current.load(std::memory_order_acquire);
+        if (!s) {
+            return Slot();
+        }
+        for (size_t i = home & s->mask, n = 0; n <= s->mask;
+             i = (i + 1) & s->mask, ++n) {
+            const Slot slot = s->slots[i].load(std::memory_order_acquire);
+            if (!slot) {
+                break;
+            }
+            if (match(slot)) {
+                return slot;
+            }
+        }
+        return Slot();
+    }
 
-inline size_t
-hash_value(const Sdf_PathNode *p)
-{
-    return TfHash()(p);
-}
+    // Return the index of the first slot in \p home's probe sequence for
+    // which \p match returns true, or NotFound.  The lock must be held.
+    template <class Match>
+    size_t Find(size_t home, Match const &match) const {
+        _Slots const *s = _current.load(std::memory_order_relaxed);
+        if (!s) {
+            return NotFound;
+        }
+        for (size_t i = home & s->mask; ; i = (i + 1) & s->mask) {
+            const Slot slot = s->slots[i].load(std::memory_order_relaxed);
+            if (!slot) {
+                return NotFound;
+            }
+            if (match(slot)) {
+                return i;
+            }
+        }
+    }
 
-template <class PaT>
-inline size_t _OuterHash(PaT const &pat)
-{
-    return TfHash::Combine(pat.parent, pat.value);
-}
+    // Return the slot at \p index.  The lock must be held.
+    Slot GetAt(size_t index) const {
+        return _current.load(std::memory_order_relaxed)->
+            slots[index].load(std::memory_order_relaxed);
+    }
 
-inline size_t _OuterHash(_ParentAnd<void> const &pat)
-{
-    return TfHash::Combine(pat.parent);
+    // Replace the slot at \p index with \p slot, which must have the same
+    // home.  The lock must be held.
+    void Replace(size_t index, Slot slot) {
+        _current.load(std::memory_order_relaxed)->slots[index].store(
+            slot, std::memory_order_release);
+    }
+
+    // Add \p slot, which must not be present.  The lock must be held.
+    void Insert(Slot slot) {
+        _Slots *s = _current.load(std::memory_order_relaxed);
+        // Keep the load factor at or below 3/4.
+        if (!s || (_size + 1) * 4 > (s->mask + 1) * 3) {
+            s = _Grow(s);
+        }
+        _Place(s, slot);
+        ++_size;
+    }
+
+    // Remove the slot at \p index, shifting later entries in its probe
+    // sequence back so no tombstones are needed.  The lock must be held.
+    void Erase(size_t index) {
+        _Slots *s = _current.load(std::memory_order_relaxed);
+        size_t hole = index;
+        for (size_t i = (hole + 1) & s->mask; ; i = (i + 1) & s->mask) {
+            const Slot slot = s->slots[i].load(std::memory_order_relaxed);
+            if (!slot) {
+                break;
+            }
+            // Leave entries whose home slot lies cyclically in (hole, i].
+            const size_t home = GetHome()(slot) & s->mask;
+            const bool stays = hole <= i ?
+                (hole < home && home <= i) : (hole < home || home <= i);
+            if (!stays) {
+                s->slots[hole].store(slot, std::memory_order_release);
+                hole = i;
+            }
+        }
+        s->slots[hole].store(Slot(), std::memory_order_release);
+        --_size;
+    }
+
+    // Invoke \p fn with every slot.  The lock must be held.
+    template <class Fn>
+    void ForEach(Fn const &fn) const {
+        _Slots const *s = _current.load(std::memory_order_relaxed);
+        if (s) {
+            for (size_t i = 0; i <= s->mask; ++i) {
+                if (const Slot slot =
+                    s->slots[i].load(std::memory_order_relaxed)) {
+                    fn(slot);
+                }
+            }
+        }
+    }
+
+    // Remove every slot and free every slot array.  The lock must be held,
+    // and no unlocked lookup may be probing this table.
+    void Clear() {
+        _current.store(nullptr, std::memory_order_relaxed);
+        std::vector<std::unique_ptr<_Slots>>().swap(_allSlots);
+        _size = 0;
+    }
+
+private:
+    struct _Slots {
+        explicit _Slots(size_t capacity)
+            : mask(capacity - 1)
+            , slots(new std::atomic<Slot>[capacity]()) {}
+        const size_t mask;
+        std::unique_ptr<std::atomic<Slot>[]> slots;
+    };
+
+    static void _Place(_Slots *s, Slot slot) {
+        size_t i = GetHome()(slot) & s->mask;
+        while (s->slots[i].load(std::memory_order_relaxed)) {
+            i = (i + 1) & s->mask;
+        }
+        s->slots[i].store(slot, std::memory_order_release);
+    }
+
+    // Build the larger array completely before publishing it.
+    _Slots *_Grow(_Slots *old) {
+        const size_t capacity = old ? (old->mask + 1) * 2 : 16;
+        _allSlots.push_back(std::make_unique<_Slots>(capacity));
+        _Slots *s = _allSlots.back().get();
+        if (old) {
+            for (size_t i = 0; i <= old->mask; ++i) {
+                if (const Slot slot =
+                    old->slots[i].load(std::memory_order_relaxed)) {
+                    _Place(s, slot);
+                }
+            }
+        }
+        _current.store(s, std::memory_order_release);
+        return s;
+    }
+
+    std::atomic<_Slots *> _current { nullptr };
+    std::vector<std::unique_ptr<_Slots>> _allSlots;
+    size_t _size = 0;
 };
 
-inline size_t _OuterHash(_ParentAndRef<void> const &pat)
-{
-    return TfHash::Combine(pat.parent);
+// One shard of a path node table: a _ProbeTable of pool handles.  Keys are
+// not stored; a candidate node's own parent and element are compared
+// instead.  Each slot holds the key's slot tag above the node's pool handle
+// value, so a slot is zero only when empty, since pool handles are never
+// zero.
+struct _NodeSlotHome {
+    size_t operator()(uint64_t slot) const {
+        return static_cast<size_t>(slot >> 32);
+    }
 };
 
-template <class HashState, class T>
-inline void TfHashAppend(HashState &h, _ParentAnd<T> const &pat)
+template <class PoolHandle>
+struct _NodeShard
 {
-    h.Append(pat.parent, pat.value);
-}
+    using _Table = _ProbeTable<uint64_t, _NodeSlotHome>;
 
-template <class HashState, class T>
-inline void TfHashAppend(HashState &h, _ParentAndRef<T> const &pat)
-{
-    h.Append(pat.parent, pat.value);
-}
+    static constexpr size_t NotFound = _Table::NotFound;
 
-template <class HashState>
-inline void TfHashAppend(HashState &h, _ParentAnd<void> const &pat)
-{
-    h.Append(pat.parent);
-}
+    static uint64_t MakeSlot(uint32_t tag, PoolHandle h) {
+        return (uint64_t(tag) << 32) | h.value;
+    }
+    static uint32_t GetTag(uint64_t slot) {
+        return static_cast<uint32_t>(slot >> 32);
+    }
+    static PoolHandle GetHandle(uint64_t slot) {
+        PoolHandle h;
+        h.value = static_cast<uint32_t>(slot);
+        return h;
+    }
 
-template <class HashState>
-inline void TfHashAppend(HashState &h, _ParentAndRef<void> const &pat)
-{
-    h.Append(pat.parent);
-}
+    // Return the handle for which \p tryMatch returns true, or a null handle.
+    // This takes no lock, so \p tryMatch may be called with handles to nodes
+    // that have died or whose memory is being reused.
+    template <class TryMatch>
+    PoolHandle FindUnlocked(uint32_t tag, TryMatch const &tryMatch) const {
+        return GetHandle(_table.FindUnlocked(tag, [&](uint64_t slot) {
+            return GetTag(slot) == tag && tryMatch(GetHandle(slot));
+        }));
+    }
 
-static constexpr unsigned NumNodeMaps = 128;
+    // Return the index of the slot whose handle satisfies \p match, or
+    // NotFound.  The mutex must be held.
+    template <class Match>
+    size_t Find(uint32_t tag, Match const &match) const {
+        return _table.Find(tag, [&](uint64_t slot) {
+            return GetTag(slot) == tag && match(GetHandle(slot));
+        });
+    }
+
+    PoolHandle GetHandleAt(size_t index) const {
+        return GetHandle(_table.GetAt(index));
+    }
+
+    // Replace the handle in the slot at \p index.  The mutex must be held.
+    void Replace(size_t index, uint32_t tag, PoolHandle h) {
+        _table.Replace(index, MakeSlot(tag, h));
+    }
+
+    // Add a handle that is not present.  The mutex must be held.
+    void Insert(uint32_t tag, PoolHandle h) {
+        _table.Insert(MakeSlot(tag, h));
+    }
+
+    // Remove the handle in the slot at \p index.  The mutex must be held.
+    void Erase(size_t index) {
+        _table.Erase(index);
+    }
+
+    // Invoke \p fn with every handle.  The mutex must be held.
+    template <class Fn>
+    void ForEach(Fn const &fn) const {
+        _table.ForEach([&fn](uint64_t slot) { fn(GetHandle(slot)); });
+    }
+
+    mutable tbb::spin_mutex mutex;
+
+private:
+    _Table _table;
+};
 
 template <class T>
 struct _PrimTable {
     using Pool = Sdf_PathPrimPartPool;
     using PoolHandle = Sdf_PathPrimHandle;
     using NodeHandle = Sdf_PathPrimNodeHandle;
+    using Shard = _NodeShard<PoolHandle>;
 
-    struct _MapAndMutex {
-        pxr_tsl::robin_map<_ParentAnd<T>, PoolHandle, TfHash> map;
-        mutable tbb::spin_mutex mutex;
-    };
-
-    _MapAndMutex &GetMapAndMutexFor(_ParentAndRef<T> const &pat) {
-        size_t z = _OuterHash(pat);
-        return _mapsAndMutexes[z & (NumNodeMaps-1)];
+    Shard &GetShardFor(size_t hash) {
+        return _shards[hash & (NumNodeMaps-1)];
     }
     
-    _MapAndMutex _mapsAndMutexes[NumNodeMaps];
-     
+    Shard _shards[NumNodeMaps];
 };
 
 template <class T>
@@ -203,18 +406,13 @@ struct _PropTable {
     using Pool = Sdf_PathPropPartPool;
     using PoolHandle = Sdf_PathPropHandle;
     using NodeHandle = Sdf_PathPropNodeHandle;
+    using Shard = _NodeShard<PoolHandle>;
 
-    struct _MapAndMutex {
-        pxr_tsl::robin_map<_ParentAnd<T>, PoolHandle, TfHash> map;
-        mutable tbb::spin_mutex mutex;
-    };
-
-    _MapAndMutex &GetMapAndMutexFor(_ParentAndRef<T> const &pat) {
-        size_t z = _OuterHash(pat);
-        return _mapsAndMutexes[z & (NumNodeMaps-1)];
+    Shard &GetShardFor(size_t hash) {
+        return _shards[hash & (NumNodeMaps-1)];
     }
     
-    _MapAndMutex _mapsAndMutexes[NumNodeMaps];
+    Shard _shards[NumNodeMaps];
 };
 
 using _PrimTokenTable = _PrimTable<TfToken>;
@@ -223,6 +421,171 @@ using _PrimVarSelTable = _PrimTable<Sdf_PathNode::VariantSelectionType>;
 using _PropTargetTable = _PropTable<SdfPath>;
 using _PropVoidTable = _PropTable<void>;
 
+// Unlocked lookups can reach the handles of nodes that have died, through
+// slots they read just before the node was erased or through slot arrays
+// replaced by growth, and read the memory of those nodes.  That memory must
+// stay intact until the lookup finishes, so the pools only return it to the
+// system after _WaitForUnlockedLookups().
+//
+// Each thread that looks up nodes registers a sequence number that is odd
+// while it is inside an unlocked lookup.  Only the owning thread writes it, so
+// entering and leaving a lookup costs two stores and a fence on a line no
+// other thread writes.
+struct _LookupThreadState
+{
+    _LookupThreadState();
+    ~_LookupThreadState();
+
+    std::atomic<uint64_t> sequence { 0 };
+    // Lookups nest when dropping a reference destroys a node.
+    unsigned depth = 0;
+};
+
+struct _LookupRegistry
+{
+    static _LookupRegistry &Get() {
+        // Leaked, since threads may exit after static destruction begins.
+        static _LookupRegistry *registry = new _LookupRegistry;
+        return *registry;
+    }
+
+    std::mutex mutex;
+    std::vector<_LookupThreadState *> threads;
+};
+
+_LookupThreadState::_LookupThreadState()
+{
+    _LookupRegistry &registry = _LookupRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(this);
+}
+
+_LookupThreadState::~_LookupThreadState()
+{
+    _LookupRegistry &registry = _LookupRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.erase(std::find(
+        registry.threads.begin(), registry.threads.end(), this));
+}
+
+class _UnlockedLookupScope
+{
+public:
+    _UnlockedLookupScope()
+        : _state(Sdf_FastThreadLocalBase<_LookupThreadState>::Get()) {
+        if (_state.depth++ == 0) {
+            _state.sequence.store(
+                _state.sequence.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+            // Order the store before the lookup's loads.  This pairs with the
+            // fence in _WaitForUnlockedLookups().
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    ~_UnlockedLookupScope() {
+        if (--_state.depth == 0) {
+            _state.sequence.store(
+                _state.sequence.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+        }
+    }
+
+private:
+    _LookupThreadState &_state;
+};
+
+// Wait for every unlocked lookup in progress to finish.  The caller has
+// already seen the nodes it is interested in erased from their tables, so
+// lookups that start later cannot reach them.
+void
+_WaitForUnlockedLookups()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _LookupRegistry &registry = _LookupRegistry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (_LookupThreadState const *thread: registry.threads) {
+        const uint64_t sequence =
+            thread->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            while (thread->sequence.load(std::memory_order_acquire) ==
+                   sequence) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+// Look for an existing node without taking the shard's lock.  For counted
+// nodes, a reference is taken before the node is examined, which keeps it
+// from dying underneath us and fails for nodes that already have; their
+// memory stays intact while the lookup runs, see _UnlockedLookupScope.
+// Uncounted nodes are never destroyed, so they can be examined directly.
+template <class PathNode, class Table, class ... Args>
+inline typename Table::PoolHandle
+_FindUnlocked(typename Table::Shard const &shard, uint32_t tag,
+              const Sdf_PathNode *parent, const Args & ... args)
+{
+    using PoolHandle = typename Table::PoolHandle;
+    using NodeHandle = typename Table::NodeHandle;
+    _UnlockedLookupScope scope;
+    return shard.FindUnlocked(tag, [&](PoolHandle h) {
+        if (!NodeHandle::IsCounted) {
+            return Access::Matches<PathNode>(h, parent, args...);
+        }
+        if (!Access::TryAddRef(h)) {
+            return false;
+        }
+        if (Access::Matches<PathNode>(h, parent, args...)) {
+            return true;
+        }
+        // Not ours.  Drop the reference we took, which may destroy the node.
+        const NodeHandle dropRef(h, /* add_ref = */ false);
+        return false;
+    });
+}
+
+// Find or create the node for \p parent and \p args with the shard's mutex
+// held.
+template <class PathNode, class Table, class ... Args>
+inline typename Table::NodeHandle
+_FindOrCreateLocked(typename Table::Shard &shard, uint32_t tag,
+                    const TfFunctionRef<bool ()> *isValid,
+                    const Sdf_PathNode *parent,
+                    const Args & ... args)
+{
+    using PoolHandle = typename Table::PoolHandle;
+    using NodeHandle = typename Table::NodeHandle;
+
+    const size_t index = shard.Find(tag, [&](PoolHandle h) {
+        return Access::Matches<PathNode>(h, parent, args...);
+    });
+    if (index != Table::Shard::NotFound) {
+        const PoolHandle h = shard.GetHandleAt(index);
+        if (!NodeHandle::IsCounted || Access::TryAddRef(h)) {
+            return NodeHandle(h, /* add_ref = */ false);
+        }
+        // There was an entry but it had begun dying (another client dropped
+        // its refcount to 0).  We have to create a new entry in the table.
+        // When the client that is deleting the other node looks for itself
+        // in the table it will find a different node and so won't remove it.
+        const PoolHandle newHandle =
+            Access::New<PathNode, typename Table::Pool>(parent, args...);
+        shard.Replace(index, tag, newHandle);
+        return NodeHandle(newHandle, /* add_ref = */ false);
+    }
+
+    // There was no entry in the table, check for validity before creating
+    // one.
+    if (isValid && ARCH_UNLIKELY(!(*isValid)())) {
+        return NodeHandle();
+    }
+    const PoolHandle newHandle =
+        Access::New<PathNode, typename Table::Pool>(parent, args...);
+    shard.Insert(tag, newHandle);
+    return NodeHandle(newHandle, /* add_ref = */ false);
+}
+
 template <class PathNode, class Table, class ... Args>
 inline typename Table::NodeHandle
 _FindOrCreate(Table &table,
@@ -230,35 +593,80 @@ _FindOrCreate(Table &table,
               const Sdf_PathNode *parent,
               const Args & ... args)
 {
-    std::pair<_ParentAndRef<Args...>, typename Table::PoolHandle>
-        newItem { { parent, args... }, {} };
-    auto &mapAndMutex = table.GetMapAndMutexFor(newItem.first);
-    tbb::spin_mutex::scoped_lock lock(mapAndMutex.mutex);
-
-    auto iresult = mapAndMutex.map.insert(newItem);
-    if (iresult.second) {
-        // There was no entry in the table, check for validity, and back out the
-        // insertion if it's invalid.
-        if (ARCH_UNLIKELY(!isValid())) {
-            mapAndMutex.map.erase(iresult.first);
-            return typename Table::NodeHandle();
+    const size_t hash = _OuterHash(_ParentAndRef<Args...> { parent, args... });
+    const uint32_t tag = _SlotTag(hash);
+    auto &shard = table.GetShardFor(hash);
+
+    // Most requests are for nodes that already exist, so look for one before
+    // taking the lock.
+    if (const typename Table::PoolHandle h =
+        _FindUnlocked<PathNode, Table>(shard, tag, parent, args...)) {
+        return typename Table::NodeHandle(h, /* add_ref = */ false);
+    }
+
+    tbb::spin_mutex::scoped_lock lock(shard.mutex);
+    return _FindOrCreateLocked<PathNode, Table>(
+        shard, tag, &isValid, parent, args...);
+}
+
+template <class PathNode, class Table, class Arg>
+inline void
+_FindOrCreateMany(Table &table,
+                  size_t count,
+                  Sdf_PathNode const * const *parents,
+                  Arg const * const *args,
+                  typename Table::NodeHandle *result)
+{
+    // Resolve existing nodes without locking, and bucket the rest by the
+    // shard they hash to, so that each shard's mutex is taken once for the
+    // whole batch.
+    std::vector<size_t> hashes(count);
+    std::vector<uint32_t> pending;
+    pending.reserve(count);
+    uint32_t shardStarts[NumNodeMaps + 1] = {};
+    for (size_t i = 0; i != count; ++i) {
+        Sdf_PathNode const *parent = parents ? parents[i] : nullptr;
+        hashes[i] = _OuterHash(_ParentAndRef<Arg> { parent, *args[i] });
+        if (const typename Table::PoolHandle h =
+            _FindUnlocked<PathNode, Table>(
+                table.GetShardFor(hashes[i]), _SlotTag(hashes[i]),
+                parent, *args[i])) {
+            result[i] = typename Table::NodeHandle(h, /* add_ref = */ false);
+            continue;
         }
+        pending.push_back(static_cast<uint32_t>(i));
+        ++shardStarts[(hashes[i] & (NumNodeMaps-1)) + 1];
     }
-    if (iresult.second ||
-        (Table::NodeHandle::IsCounted &&
-         (Access::GetRefCount(
-             iresult.first->second).fetch_add(1) &
-          Sdf_PathNode::RefCountMask) == 0)) {
-        // There was either no entry, or there was one but it had begun dying
-        // (another client dropped its refcount to 0).  We have to create a new
-        // entry in the table.  When the client that is deleting the other node
-        // it looks for itself in the table.  It will either not find itself or
-        // will find a different node and so won't remove it.
-        iresult.first.value() =
-            Access::New<PathNode, typename Table::Pool>(parent, args...);
+    if (pending.empty()) {
+        return;
+    }
+    for (unsigned i = 0; i != NumNodeMaps; ++i) {
+        shardStarts[i + 1] += shardStarts[i];
+    }
+    std::vector<uint32_t> order(pending.size());
+    {
+        uint32_t cursors[NumNodeMaps];
+        std::copy(shardStarts, shardStarts + NumNodeMaps, cursors);
+        for (const uint32_t i: pending) {
+            order[cursors[hashes[i] & (NumNodeMaps-1)]++] = i;
+        }
+    }
+
+    for (unsigned shardIndex = 0; shardIndex != NumNodeMaps; ++shardIndex) {
+        const uint32_t begin = shardStarts[shardIndex];
+        const uint32_t end = shardStarts[shardIndex + 1];
+        if (begin == end) {
+            continue;
+        }
+        auto &shard = table._shards[shardIndex];
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        for (uint32_t j = begin; j != end; ++j) {
+            const uint32_t i = order[j];
+            result[i] = _FindOrCreateLocked<PathNode, Table>(
+                shard, _SlotTag(hashes[i]), /* isValid = */ nullptr,
+                parents ? parents[i] : nullptr, *args[i]);
+        }
     }
-    return typename Table::NodeHandle(
-        iresult.first->second, /* add_ref = */ false);
 }
 
 template <class Table, class ... Args>
@@ -271,14 +679,17 @@ _Remove(const Sdf_PathNode *pathNode,
     // there's an entry present it may not be pathNode, since another node may
     // have been created since we decremented our refcount and started being
     // destroyed.  If it is this node, we remove it.
-    _ParentAndRef<Args...> pat { parent.get(), args... };
-    auto &mapAndMutex = table.GetMapAndMutexFor(pat);
-    tbb::spin_mutex::scoped_lock lock(mapAndMutex.mutex);
-
-    auto iter = mapAndMutex.map.find(pat);
-    if (iter != mapAndMutex.map.end() &&
-        iter->second.GetPtr() == reinterpret_cast<char const *>(pathNode)) {
-        mapAndMutex.map.erase_fast(iter);
+    const size_t hash =
+        _OuterHash(_ParentAndRef<Args...> { parent.get(), args... });
+    auto &shard = table.GetShardFor(hash);
+    tbb::spin_mutex::scoped_lock lock(shard.mutex);
+
+    const size_t index = shard.Find(
+        _SlotTag(hash), [pathNode](typename Table::PoolHandle h) {
+            return h.GetPtr() == reinterpret_cast<char const *>(pathNode);
+        });
+    if (index != Table::Shard::NotFound) {
+        shard.Erase(index);
     }
 }
 
@@ -359,6 +770,26 @@ Sdf_PathNode::FindOrCreatePrimProperty(Sdf_PathNode const *parent,
         *_primPropertyNodes, isValid, nullptr, name);
 }
     
+void
+Sdf_PathNode::FindOrCreatePrims(size_t count,
+                                Sdf_PathNode const * const *parents,
+                                TfToken const * const *names,
+                                Sdf_PathPrimNodeHandle *result)
+{
+    _FindOrCreateMany<Sdf_PrimPathNode>(
+        *_primNodes, count, parents, names, result);
+}
+
+void
+Sdf_PathNode::FindOrCreatePrimProperties(size_t count,
+                                         TfToken const * const *names,
+                                         Sdf_PathPropNodeHandle *result)
+{
+    // As in FindOrCreatePrimProperty, property nodes have no parent.
+    _FindOrCreateMany<Sdf_PrimPropertyPathNode>(
+        *_primPropertyNodes, count, nullptr, names, result);
+}
+
 Sdf_PathPrimNodeHandle
 Sdf_PathNode::FindOrCreatePrimVariantSelection(
     Sdf_PathNode const *parent, 
@@ -434,59 +865,234 @@ Sdf_PathNode::_GetEmptyVariantSelection() const {
 }
 
 namespace {
-// This "table" is a thread-safe mapping from property node to path token.  Each
-// entry in the _pathTokenTable points to one of these, and will have an entry
-// for the path string for the prim path itself (which will be keyed with a
-// nullptr property node pointer) plus all the properties that hang off it.
-struct _PropToTokenTable
-{
-    // Note that this function returns a TfToken lvalue reference that needs to
-    // live/be valid as long as this object is around.
+// This table is a thread-safe mapping from path nodes to path tokens.  It has a
+// block for each prim node whose path token, or the token of a property path
+// on it, has been requested.  A block holds the prim path's token and a
+// _ProbeTable from property node to token.  Tokens never move once created,
+// so the references GetPathToken returns stay valid until the prim node dies
+// and its block is released.
+//
+// Lookups take no locks.  Blocks are found through sharded _ProbeTables of
+// block pointers, and writers insert and remove blocks with the shard's mutex
+// held.  A lookup that races with a writer can only miss, and a miss retries
+// with the lock held.  Released blocks are recycled rather than freed, so a
+// lookup probing stale slots always reads valid memory; it checks a block's
+// prim before using it.  A block's tokens are only read by lookups for its
+// own prim, which the caller keeps alive, so they can be freed when the block
+// is released.
+class _PathTokenTable
+{
+public:
+    // Return the token for \p prim and \p prop if there is one, else null.
+    TfToken const *
+    Find(Sdf_PathNode const *prim, Sdf_PathNode const *prop) const {
+        const size_t hash = TfHash()(prim);
+        _PrimBlock const *block = _FindBlock(_GetShard(hash), prim, hash);
+        return block ? _FindToken(*block, prop) : nullptr;
+    }
+
+    // Return the token for \p prim and \p prop, calling \p makeToken to
+    // create it if there is none.
     template <class Fn>
     TfToken const &
-    FindOrCreate(Sdf_PathNode const *prop, Fn &&makeToken) {
-        _Data &d = *_data;
-        // We try first without creating the token -- if that fails we try
-        // again.  This could be made more efficient, but getting strings for
-        // paths shouldn't be a bottleneck for clients.
-        tbb::spin_mutex::scoped_lock lock(d.mutex);
-        auto iter = d.propsToToks.find(prop);
-        if (iter == d.propsToToks.end()) {
-            // No entry yet.  Drop the lock, make the token, and try to insert
-            // it.  We *must* drop the lock since creating the token can
-            // re-enter here (e.g. if there are embedded target paths that have
-            // properties on the same prim).
-            lock.release();
-            TfToken tok = std::forward<Fn>(makeToken)();
-            lock.acquire(d.mutex);
-            // This may or may not actually insert the token, depending on
-            // whether or not a concurrent caller did, but it doesn't really
-            // matter.
-            iter = d.propsToToks.emplace(prop, std::move(tok)).first;
+    FindOrCreate(Sdf_PathNode const *prim, Sdf_PathNode const *prop,
+                 Fn const &makeToken) {
+        const size_t hash = TfHash()(prim);
+        _Shard &shard = _GetShard(hash);
+        _PrimBlock *block = _FindBlock(shard, prim, hash);
+        if (!block) {
+            block = _FindOrInsertBlock(shard, prim, hash);
+        }
+        if (TfToken const *token = _FindToken(*block, prop)) {
+            return *token;
+        }
+
+        // We *must not* hold a lock while making the token since creating it
+        // can re-enter here (e.g. if there are embedded target paths that have
+        // properties on the same prim).
+        TfToken token = makeToken();
+        tbb::spin_mutex::scoped_lock lock(block->mutex);
+        // A concurrent caller may have inserted the token already.
+        if (TfToken const *existing = _FindToken(*block, prop)) {
+            return *existing;
         }
-        return iter->second;
+        return _InsertToken(*block, prop, std::move(token));
     }
 
+    // Release the block for \p prim, if any.  No other thread may be looking
+    // up tokens for \p prim.
+    void Remove(Sdf_PathNode const *prim);
+
 private:
-    struct _Data {
-        std::map<Sdf_PathNode const *, TfToken> propsToToks;
+    static constexpr size_t NumShards = 128;
+
+    struct _PropEntry {
+        Sdf_PathNode const *prop;
+        TfToken token;
+    };
+
+    struct _PropHome {
+        size_t operator()(_PropEntry const *entry) const {
+            return TfHash()(entry->prop);
+        }
+    };
+
+    struct _PrimBlock {
+        std::atomic<Sdf_PathNode const *> prim { nullptr };
+        std::atomic<TfToken const *> primToken { nullptr };
+
+        // Modified only with mutex held.
+        _ProbeTable<_PropEntry *, _PropHome> props;
+
+        // The rest is only accessed with mutex held.
         tbb::spin_mutex mutex;
+        std::unique_ptr<TfToken> primTokenStorage;
+        std::vector<std::unique_ptr<_PropEntry>> propEntries;
+        _PrimBlock *nextFree = nullptr;
     };
 
-    std::shared_ptr<_Data> _data { new _Data };
+    // The low bits of a prim's hash pick its shard, the high bits its slot.
+    static size_t _GetHome(size_t hash) {
+        return static_cast<size_t>(uint64_t(hash) >> 32);
+    }
+
+    struct _BlockHome {
+        size_t operator()(_PrimBlock const *block) const {
+            return _GetHome(TfHash()(
+                block->prim.load(std::memory_order_relaxed)));
+        }
+    };
+
+    struct _Shard {
+        // Modified only with mutex held.
+        _ProbeTable<_PrimBlock *, _BlockHome> blocks;
+
+        // The rest is only accessed with mutex held.
+        tbb::spin_mutex mutex;
+        std::vector<std::unique_ptr<_PrimBlock>> allBlocks;
+        _PrimBlock *freeBlocks = nullptr;
+    };
+
+    _Shard &_GetShard(size_t hash) {
+        return _shards[hash & (NumShards - 1)];
+    }
+    _Shard const &_GetShard(size_t hash) const {
+        return _shards[hash & (NumShards - 1)];
+    }
+
+    static _PrimBlock *
+    _FindBlock(_Shard const &shard, Sdf_PathNode const *prim, size_t hash) {
+        return shard.blocks.FindUnlocked(
+            _GetHome(hash), [prim](_PrimBlock const *block) {
+                return block->prim.load(std::memory_order_acquire) == prim;
+            });
+    }
+
+    static TfToken const *
+    _FindToken(_PrimBlock const &block, Sdf_PathNode const *prop) {
+        if (!prop) {
+            return block.primToken.load(std::memory_order_acquire);
+        }
+        // Property tables only grow, so an unlocked probe can only miss
+        // entries inserted concurrently.
+        _PropEntry const *entry = block.props.FindUnlocked(
+            TfHash()(prop), [prop](_PropEntry const *e) {
+                return e->prop == prop;
+            });
+        return entry ? &entry->token : nullptr;
+    }
+
+    _PrimBlock *
+    _FindOrInsertBlock(_Shard &shard, Sdf_PathNode const *prim, size_t hash);
+
+    static TfToken const &
+    _InsertToken(_PrimBlock &block, Sdf_PathNode const *prop, TfToken token);
+
+    _Shard _shards[NumShards];
 };
 
-} // anon
+_PathTokenTable::_PrimBlock *
+_PathTokenTable::_FindOrInsertBlock(
+    _Shard &shard, Sdf_PathNode const *prim, size_t hash)
+{
+    tbb::spin_mutex::scoped_lock lock(shard.mutex);
+    if (_PrimBlock *block = _FindBlock(shard, prim, hash)) {
+        return block;
+    }
 
-using _PrimToPropTokenTables =
-    tbb::concurrent_hash_map<Sdf_PathNode const *, _PropToTokenTable>;
+    _PrimBlock *block = shard.freeBlocks;
+    if (block) {
+        shard.freeBlocks = block->nextFree;
+        block->nextFree = nullptr;
+    }
+    else {
+        shard.allBlocks.push_back(std::make_unique<_PrimBlock>());
+        block = shard.allBlocks.back().get();
+    }
+    block->prim.store(prim, std::memory_order_release);
+    shard.blocks.Insert(block);
+    return block;
+}
 
-static TfStaticData<_PrimToPropTokenTables> _pathTokenTable;
+TfToken const &
+_PathTokenTable::_InsertToken(
+    _PrimBlock &block, Sdf_PathNode const *prop, TfToken token)
+{
+    if (!prop) {
+        block.primTokenStorage.reset(new TfToken(std::move(token)));
+        block.primToken.store(block.primTokenStorage.get(),
+                              std::memory_order_release);
+        return *block.primTokenStorage;
+    }
+
+    block.propEntries.push_back(
+        std::unique_ptr<_PropEntry>(new _PropEntry { prop, std::move(token) }));
+    _PropEntry *entry = block.propEntries.back().get();
+    block.props.Insert(entry);
+    return entry->token;
+}
+
+void
+_PathTokenTable::Remove(Sdf_PathNode const *prim)
+{
+    const size_t hash = TfHash()(prim);
+    _Shard &shard = _GetShard(hash);
+    tbb::spin_mutex::scoped_lock lock(shard.mutex);
+
+    const size_t index = shard.blocks.Find(
+        _GetHome(hash), [prim](_PrimBlock const *block) {
+            return block->prim.load(std::memory_order_relaxed) == prim;
+        });
+    if (index == shard.blocks.NotFound) {
+        return;
+    }
+    _PrimBlock *block = shard.blocks.GetAt(index);
+    shard.blocks.Erase(index);
+
+    // Free the block's tokens and recycle the block itself, since lookups for
+    // other prims may still read its prim.
+    block->prim.store(nullptr, std::memory_order_release);
+    block->primToken.store(nullptr, std::memory_order_relaxed);
+    block->props.Clear();
+    block->primTokenStorage.reset();
+    std::vector<std::unique_ptr<_PropEntry>>().swap(block->propEntries);
+    block->nextFree = shard.freeBlocks;
+    shard.freeBlocks = block;
+}
+
+} // anon
+
+static TfStaticData<_PathTokenTable> _pathTokenTable;
 
 const TfToken &
 Sdf_PathNode::GetPathToken(Sdf_PathNode const *primPart,
                            Sdf_PathNode const *propPart)
 {
+    // Most requests are for tokens that already exist.
+    if (TfToken const *token = _pathTokenTable->Find(primPart, propPart)) {
+        return *token;
+    }
+
     // Set the cache bit.  We only ever read this during the dtor, and that has
     // to be exclusive to all other execution.
     primPart->_refCount.fetch_or(HasTokenBit, std::memory_order_relaxed);
@@ -495,16 +1101,8 @@ Sdf_PathNode::GetPathToken(Sdf_PathNode const *primPart,
     TfAutoMallocTag2 tag("Sdf", "SdfPath");
     TfAutoMallocTag tag2("Sdf_PathNode::GetPathToken");
 
-    _PrimToPropTokenTables::accessor primAccessor;
-    _pathTokenTable->insert(
-        primAccessor, std::make_pair(primPart, _PropToTokenTable()));
-    auto &propToTokenTable = primAccessor->second;
-    // Release the primAccessor here, since the call to _CreatePathToken below
-    // can cause reentry here (for embedded target paths).
-    primAccessor.release();
-
-    return propToTokenTable.FindOrCreate(
-        propPart, [primPart, propPart]() {
+    return _pathTokenTable->FindOrCreate(
+        primPart, propPart, [primPart, propPart]() {
             return Sdf_PathNode::_CreatePathToken(primPart, propPart);
         });
 }
@@ -693,7 +1291,7 @@ Sdf_PathNode::GetDebugText(Sdf_PathNode const *primPart,
 void
 Sdf_PathNode::_RemovePathTokenFromTable() const
 {
-    _pathTokenTable->erase(this);
+    _pathTokenTable->Remove(this);
 }
 
 // Returns true if \p identifier has at least one namespace delimiter.
@@ -870,14 +1468,14 @@ _GatherChildrenFrom(Sdf_PathNode const *parent,
                     vector<Sdf_PathNodeConstRefPtr> *result)
 {
     for (size_t outerIndex = 0; outerIndex != NumNodeMaps; ++outerIndex) {
-        auto &mapAndMutex = table._mapsAndMutexes[outerIndex];
-        tbb::spin_mutex::scoped_lock lock(mapAndMutex.mutex);
-        TF_FOR_ALL(i, mapAndMutex.map) {
-            if (i->first.parent == parent)
-                result->emplace_back(
-                    TfDelegatedCountIncrementTag,
-                    reinterpret_cast<Sdf_PathNode const *>(i->second.GetPtr()));
-        }
+        auto &shard = table._shards[outerIndex];
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        shard.ForEach([parent, result](typename Table::PoolHandle h) {
+            Sdf_PathNode const *node =
+                reinterpret_cast<Sdf_PathNode const *>(h.GetPtr());
+            if (node->GetParentNode() == parent)
+                result->emplace_back(TfDelegatedCountIncrementTag, node);
+        });
     }
 }
 
@@ -985,7 +1583,42 @@ void Sdf_DumpPathStats()
     printf("\tavg num children (for nodes with any children): %g\n",
            numChildren / float(stats.numNodes - stats.numChildrenTable[0]));
 
+    const SdfPathPoolStats poolStats = SdfPathGetPoolStats();
+    printf("------------------------------------------------\n");
+    printf("-- Node Pools\n");
+    printf("\tlive nodes (upper bound): %zu\n", poolStats.liveNodes);
+    printf("\tshared free-list nodes:   %zu\n", poolStats.freeListNodes);
+    printf("\treserved bytes:           %zu\n", poolStats.reservedBytes);
+    printf("\tcommitted bytes:          %zu\n", poolStats.committedBytes);
+    printf("\treleased bytes:           %zu\n", poolStats.releasedBytes);
+
     printf("\n");
 }
 
+SdfPathPoolStats
+SdfPathGetPoolStats()
+{
+    const Sdf_PoolStats primStats = Sdf_PathPrimPartPool::GetStats();
+    const Sdf_PoolStats propStats = Sdf_PathPropPartPool::GetStats();
+
+    SdfPathPoolStats stats;
+    stats.liveNodes = primStats.liveElements + propStats.liveElements;
+    stats.freeListNodes =
+        primStats.freeListElements + propStats.freeListElements;
+    stats.reservedBytes = primStats.reservedBytes + propStats.reservedBytes;
+    stats.committedBytes =
+        primStats.committedBytes + propStats.committedBytes;
+    stats.releasedBytes = primStats.releasedBytes + propStats.releasedBytes;
+    return stats;
+}
+
+size_t
+SdfPathReleaseUnusedPoolMemory()
+{
+    TRACE_FUNCTION();
+    return Sdf_PathPrimPartPool::ReleaseUnusedMemory(
+               _WaitForUnlockedLookups) +
+        Sdf_PathPropPartPool::ReleaseUnusedMemory(_WaitForUnlockedLookups);
+}
+
 SDF_NAMESPACE_CLOSE_SCOPE
@@ -120,6 +120,21 @@ public:
     FindOrCreatePrimProperty(
         Sdf_PathNode const *parent, const TfToken &name,
         TfFunctionRef<bool ()> isValid);
+
+    // Bulk forms of FindOrCreatePrim and FindOrCreatePrimProperty.  Set
+    // result[i] to the node for parents[i] and names[i] for each i less than
+    // count, taking each node table lock at most once.  The caller must have
+    // checked that every name is valid for its parent.
+    static void
+    FindOrCreatePrims(size_t count,
+                      Sdf_PathNode const * const *parents,
+                      TfToken const * const *names,
+                      Sdf_PathPrimNodeHandle *result);
+
+    static void
+    FindOrCreatePrimProperties(size_t count,
+                               TfToken const * const *names,
+                               Sdf_PathPropNodeHandle *result);
     
     static Sdf_PathPrimNodeHandle
     FindOrCreatePrimVariantSelection(Sdf_PathNode const *parent,
@@ -229,7 +244,9 @@ public:
 protected:
     Sdf_PathNode(Sdf_PathNode const *parent, NodeType nodeType)
         : _parent(TfDelegatedCountIncrementTag, parent)
-        , _refCount(1)
+        // The initial reference is published once construction completes,
+        // see Sdf_PathNodePrivateAccess::New().
+        , _refCount(0)
         , _elementCount(parent ? parent->_elementCount + 1 : 1)
         , _nodeType(nodeType)
         , _nodeFlags(
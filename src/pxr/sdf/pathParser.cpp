@@ -7,6 +7,9 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/pathParser.h"
+#include <pxr/tf/smallVector.h>
+
+#include <algorithm>
 
 SDF_NAMESPACE_OPEN_SCOPE
 
@@ -158,8 +161,149 @@ struct Action<Expression> {
 
 }
 
+namespace {
+
+// Character classes for the ASCII identifiers _ParseSimpleAbsolutePath
+// accepts.  These agree with Utf8IdentifierStart and XidContinue on ASCII.
+enum : unsigned char { _IdStart = 1, _IdContinue = 2 };
+
+struct _CharClasses
+{
+    constexpr _CharClasses() : classes() {
+        for (int c = 'a'; c <= 'z'; ++c) {
+            classes[c] = _IdStart | _IdContinue;
+        }
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            classes[c] = _IdStart | _IdContinue;
+        }
+        for (int c = '0'; c <= '9'; ++c) {
+            classes[c] = _IdContinue;
+        }
+        classes[int('_')] = _IdStart | _IdContinue;
+    }
+
+    bool IsStart(char c) const {
+        return classes[static_cast<unsigned char>(c)] & _IdStart;
+    }
+    bool IsContinue(char c) const {
+        return classes[static_cast<unsigned char>(c)] & _IdContinue;
+    }
+
+    unsigned char classes[256];
+};
+
+constexpr _CharClasses _charClasses;
+
+// Return the index just past the ASCII identifier starting at \p pos in \p s,
+// or \p pos if there is none.
+inline size_t
+_ScanIdentifier(char const *s, size_t pos, size_t len)
+{
+    if (pos == len || !_charClasses.IsStart(s[pos])) {
+        return pos;
+    }
+    for (++pos; pos != len && _charClasses.IsContinue(s[pos]); ++pos) {
+    }
+    return pos;
+}
+
+TfToken
+_MakeToken(char const *begin, size_t size)
+{
+    constexpr size_t BufSz = 32;
+    if (size < BufSz) {
+        // copy & null-terminate.
+        char buf[BufSz];
+        std::copy(begin, begin + size, buf);
+        buf[size] = '\0';
+        return TfToken(buf);
+    }
+    return TfToken(std::string(begin, size));
+}
+
+// Build \p path from \p pathStr if it is a plain ASCII absolute prim or prim
+// property path, like "/World/Geom/mesh_0.points" or "/Looks/mat.inputs:rgb",
+// which is by far the most common shape.  Return false for anything else so
+// the caller can use the full grammar.  If \p path is null, just check the
+// string.
+bool
+_ParseSimpleAbsolutePath(std::string const &pathStr, SdfPath *path)
+{
+    char const * const s = pathStr.data();
+    const size_t len = pathStr.size();
+    if (len == 0 || s[0] != '/') {
+        return false;
+    }
+
+    // Check the whole string before creating any path nodes, recording where
+    // each prim name ends and where the property name starts.
+    TfSmallVector<size_t, 16> primNameEnds;
+    size_t propNameStart = 0;
+    for (size_t pos = 1; pos != len; ) {
+        const size_t end = _ScanIdentifier(s, pos, len);
+        if (end == pos) {
+            return false;
+        }
+        primNameEnds.push_back(end);
+        if (end == len) {
+            break;
+        }
+        if (s[end] == '.') {
+            propNameStart = end + 1;
+            break;
+        }
+        if (s[end] != '/' || end + 1 == len) {
+            return false;
+        }
+        pos = end + 1;
+    }
+    if (propNameStart) {
+        // One or more identifiers separated by namespace delimiters.
+        for (size_t pos = propNameStart; ; ++pos) {
+            const size_t end = _ScanIdentifier(s, pos, len);
+            if (end == pos) {
+                return false;
+            }
+            if (end == len) {
+                break;
+            }
+            if (s[end] != SDF_PATH_NS_DELIMITER_CHAR) {
+                return false;
+            }
+            pos = end;
+        }
+    }
+
+    if (path) {
+        SdfPath result = SdfPath::AbsoluteRootPath();
+        size_t begin = 1;
+        for (const size_t end: primNameEnds) {
+            result = result.AppendChild(_MakeToken(s + begin, end - begin));
+            begin = end + 1;
+        }
+        if (propNameStart) {
+            result = result.AppendProperty(
+                _MakeToken(s + propNameStart, len - propNameStart));
+        }
+        *path = std::move(result);
+    }
+    return true;
+}
+
+} // anon
+
 bool
 Sdf_ParsePath(std::string const &pathStr, SdfPath *path, std::string *errMsg)
+{
+    if (_ParseSimpleAbsolutePath(pathStr, path)) {
+        return true;
+    }
+    return Sdf_ParsePathWithGrammar(pathStr, path, errMsg);
+}
+
+bool
+Sdf_ParsePathWithGrammar(
+    std::string const &pathStr, SdfPath *path, std::string *errMsg)
 {
     Sdf_PathParser::PPContext context;
     try {
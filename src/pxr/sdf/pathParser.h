@@ -20,6 +20,14 @@ SDF_NAMESPACE_OPEN_SCOPE
 bool
 Sdf_ParsePath(std::string const &pathStr, SdfPath *path, std::string *errMsg);
 
+// Parse \p pathStr with the full path grammar, without first trying the
+// scanner Sdf_ParsePath uses for plain absolute paths.  Tests use this to
+// check that the two agree.
+SDF_API
+bool
+Sdf_ParsePathWithGrammar(
+    std::string const &pathStr, SdfPath *path, std::string *errMsg);
+
 namespace Sdf_PathParser {
 
 namespace PEGTL_NS = PXR_PEGTL_NAMESPACE;
@@ -0,0 +1,152 @@
+#include "pxr/sdf/pxr.h"
+#include "pxr/sdf/pathPrefixMapper.h"
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/mallocTag.h>
+#include <pxr/trace/trace.h>
+#include <pxr/work/loops.h>
+
+#include <algorithm>
+
+SDF_NAMESPACE_OPEN_SCOPE
+
+// MapMany() starts over with an empty memo once this many ancestors are
+// recorded, to bound the memory it holds on to in large chunks.
+static constexpr size_t _MaxAncestorMemoSize = 4096;
+
+SdfPathPrefixMapper::SdfPathPrefixMapper(
+    std::vector<Replacement> const &replacements, bool fixTargetPaths)
+    : _fixTargetPaths(fixTargetPaths)
+{
+    TRACE_FUNCTION();
+
+    _replacements.reserve(replacements.size());
+    for (Replacement const &replacement: replacements) {
+        _AddReplacement(replacement.first, replacement.second);
+    }
+}
+
+SdfPathPrefixMapper::SdfPathPrefixMapper(
+    SdfPath const &oldPrefix, SdfPath const &newPrefix, bool fixTargetPaths)
+    : _fixTargetPaths(fixTargetPaths)
+{
+    _AddReplacement(oldPrefix, newPrefix);
+}
+
+void
+SdfPathPrefixMapper::_AddReplacement(SdfPath const &oldPrefix,
+                                     SdfPath const &newPrefix)
+{
+    if (!oldPrefix.IsAbsolutePath()) {
+        TF_CODING_ERROR("Cannot replace prefix <%s>: prefixes must be "
+                        "absolute paths", oldPrefix.GetText());
+        return;
+    }
+    // Keep replacements that map a prefix to itself: they still shadow the
+    // replacements for shorter prefixes.
+    if (!_replacements.emplace(oldPrefix, newPrefix).second) {
+        TF_CODING_ERROR("Prefix <%s> is replaced more than once",
+                        oldPrefix.GetText());
+        return;
+    }
+
+    const size_t depth = oldPrefix.GetPathElementCount();
+    _minDepth = _replacements.size() == 1 ? depth : std::min(_minDepth, depth);
+}
+
+bool
+SdfPathPrefixMapper::_IsUnmapped(SdfPath const &path) const
+{
+    // Relative paths cannot have an absolute prefix, and walking up their
+    // parents never ends, so leave them alone.  Absolute paths shallower
+    // than every old prefix can only change through their target paths.
+    return _replacements.empty() || !path.IsAbsolutePath() ||
+        (path.GetPathElementCount() < _minDepth &&
+         !(_fixTargetPaths && path.ContainsTargetPath()));
+}
+
+SdfPath
+SdfPathPrefixMapper::_MapUnder(SdfPath const &path,
+                               SdfPath const &parent,
+                               SdfPath const &mappedParent) const
+{
+    if (mappedParent.IsEmpty()) {
+        return SdfPath();
+    }
+
+    // Every other element is carried over as is, but target and mapper
+    // elements hold a path of their own to map.
+    if (_fixTargetPaths && (path.IsTargetPath() || path.IsMapperPath())) {
+        SdfPath const &target = path.GetTargetPath();
+        const SdfPath mappedTarget = Map(target);
+        if (mappedTarget == target && mappedParent == parent) {
+            return path;
+        }
+        if (mappedTarget.IsEmpty()) {
+            return SdfPath();
+        }
+        return path.IsTargetPath() ?
+            mappedParent.AppendTarget(mappedTarget) :
+            mappedParent.AppendMapper(mappedTarget);
+    }
+
+    if (mappedParent == parent) {
+        return path;
+    }
+    return path.ReplacePrefix(parent, mappedParent, /*fixTargetPaths=*/false);
+}
+
+SdfPath
+SdfPathPrefixMapper::Map(SdfPath const &path) const
+{
+    return _Map(path, nullptr);
+}
+
+SdfPath
+SdfPathPrefixMapper::_Map(SdfPath const &path, _AncestorMemo *memo) const
+{
+    if (_IsUnmapped(path)) {
+        return path;
+    }
+    if (SdfPath const *newPrefix = FindReplacement(path)) {
+        return *newPrefix;
+    }
+
+    // The path has no replacement of its own, so its longest old prefix is
+    // its parent's.  This ends at the absolute root, which is either an old
+    // prefix or shallower than all of them.
+    SdfPath parent = path.GetParentPath();
+    if (!memo) {
+        return _MapUnder(path, parent, _Map(parent, nullptr));
+    }
+    auto iter = memo->find(parent);
+    if (iter == memo->end()) {
+        SdfPath mappedParent = _Map(parent, memo);
+        iter = memo->emplace(std::move(parent), std::move(mappedParent)).first;
+    }
+    return _MapUnder(path, iter->first, iter->second);
+}
+
+SdfPathVector
+SdfPathPrefixMapper::MapMany(SdfPathVector const &paths) const
+{
+    TfAutoMallocTag2 tag("Sdf", "SdfPathPrefixMapper::MapMany");
+    TRACE_FUNCTION();
+
+    SdfPathVector result(paths.size());
+    WorkParallelForN(
+        paths.size(),
+        [this, &paths, &result](size_t begin, size_t end) {
+            // Paths in a chunk often share ancestors, so remember them.
+            _AncestorMemo memo;
+            for (size_t i = begin; i != end; ++i) {
+                if (memo.size() > _MaxAncestorMemoSize) {
+                    memo.clear();
+                }
+                result[i] = _Map(paths[i], &memo);
+            }
+        },
+        /*grainSize=*/1024);
+    return result;
+}
+
+SDF_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,109 @@
+#ifndef PXR_SDF_PATH_PREFIX_MAPPER_H
+#define PXR_SDF_PATH_PREFIX_MAPPER_H
+
+#include "pxr/sdf/pxr.h"
+#include "pxr/sdf/api.h"
+#include "pxr/sdf/path.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+SDF_NAMESPACE_OPEN_SCOPE
+
+/// \class SdfPathPrefixMapper
+///
+/// A precompiled set of path prefix replacements that maps paths the way
+/// SdfPath::ReplacePrefix() does, but for many prefixes and many paths at
+/// once.
+///
+/// Each path is mapped by its longest prefix among the old prefixes, so a
+/// mapper built from {/A -> /X, /A/B -> /Y} maps /A/B/C to /Y/C and /A/D to
+/// /X/D.  Paths with no old prefix are returned unchanged.  When
+/// \p fixTargetPaths is true, target and mapper paths embedded in a path are
+/// mapped too, as SdfPath::ReplacePrefix() does by default.
+///
+/// The replacements are keyed by path node, and a path is mapped by
+/// following its node chain up to the first node with a replacement, so
+/// mapping costs one hash lookup per path element at or below the depth of
+/// the shallowest old prefix, regardless of how many replacements there
+/// are.  Paths are only rebuilt when something under them changes.
+/// MapMany() additionally remembers the ancestors each thread has mapped,
+/// so paths that share a parent, like siblings, mostly map in a single
+/// lookup and append per path, in any order.
+///
+/// The old prefixes must be absolute.  A replacement with an empty new
+/// prefix maps the paths under its old prefix to the empty path.  A mapper
+/// is immutable once built and may be used from several threads at once.
+///
+class SdfPathPrefixMapper
+{
+public:
+    using Replacement = std::pair<SdfPath, SdfPath>;
+
+    /// Construct a mapper that maps every path to itself.
+    SdfPathPrefixMapper() = default;
+
+    /// Construct a mapper from (old prefix, new prefix) \p replacements.
+    SDF_API
+    explicit SdfPathPrefixMapper(std::vector<Replacement> const &replacements,
+                                 bool fixTargetPaths = true);
+
+    /// Construct a mapper that replaces the single prefix \p oldPrefix with
+    /// \p newPrefix.
+    SDF_API
+    SdfPathPrefixMapper(SdfPath const &oldPrefix, SdfPath const &newPrefix,
+                        bool fixTargetPaths = true);
+
+    /// Return true if this mapper has no replacements.
+    bool IsEmpty() const {
+        return _replacements.empty();
+    }
+
+    /// Return the number of replacements.
+    size_t GetNumReplacements() const {
+        return _replacements.size();
+    }
+
+    /// Return the new prefix for \p oldPrefix, or nullptr if \p oldPrefix
+    /// is not one of the old prefixes.
+    SdfPath const *FindReplacement(SdfPath const &oldPrefix) const {
+        auto iter = _replacements.find(oldPrefix);
+        return iter == _replacements.end() ? nullptr : &iter->second;
+    }
+
+    /// Return \p path with its longest old prefix replaced.
+    SDF_API
+    SdfPath Map(SdfPath const &path) const;
+
+    /// Return \p paths mapped as by Map(), computed in parallel.
+    SDF_API
+    SdfPathVector MapMany(SdfPathVector const &paths) const;
+
+private:
+    void _AddReplacement(SdfPath const &oldPrefix, SdfPath const &newPrefix);
+
+    // Return true if nothing at or above \p path can be mapped.
+    bool _IsUnmapped(SdfPath const &path) const;
+
+    // Mapped ancestors, keyed by their original path.
+    using _AncestorMemo = std::unordered_map<SdfPath, SdfPath, SdfPath::Hash>;
+
+    // Map \p path, looking up and recording its mapped ancestors in
+    // \p memo if it is not null.
+    SdfPath _Map(SdfPath const &path, _AncestorMemo *memo) const;
+
+    // Map \p path, whose parent is \p parent and maps to \p mappedParent,
+    // when \p path itself has no replacement.
+    SdfPath _MapUnder(SdfPath const &path,
+                      SdfPath const &parent,
+                      SdfPath const &mappedParent) const;
+
+    std::unordered_map<SdfPath, SdfPath, SdfPath::Hash> _replacements;
+    size_t _minDepth = 0;
+    bool _fixTargetPaths = true;
+};
+
+SDF_NAMESPACE_CLOSE_SCOPE
+
+#endif // PXR_SDF_PATH_PREFIX_MAPPER_H
@@ -0,0 +1,314 @@
+#include "pxr/sdf/pxr.h"
+#include "pxr/sdf/pathSortedSet.h"
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/smallVector.h>
+#include <pxr/trace/trace.h>
+
+#include <algorithm>
+#include <iterator>
+
+SDF_NAMESPACE_OPEN_SCOPE
+
+SdfPathSortedSet::SdfPathSortedSet(SdfPathVector paths)
+    : _paths(std::move(paths))
+{
+    TRACE_FUNCTION();
+
+    std::sort(_paths.begin(), _paths.end());
+    _paths.erase(std::unique(_paths.begin(), _paths.end()), _paths.end());
+    _BuildIndex();
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::FromSorted(SdfPathVector paths)
+{
+    TF_DEV_AXIOM(std::adjacent_find(
+                     paths.begin(), paths.end(),
+                     [](SdfPath const &l, SdfPath const &r) {
+                         return !(l < r);
+                     }) == paths.end());
+
+    SdfPathSortedSet result;
+    result._paths = std::move(paths);
+    result._BuildIndex();
+    return result;
+}
+
+void
+SdfPathSortedSet::clear()
+{
+    _paths.clear();
+    _entries.clear();
+}
+
+void
+SdfPathSortedSet::_BuildIndex()
+{
+    TF_AXIOM(_paths.size() < _NoIndex);
+
+    const uint32_t numPaths = static_cast<uint32_t>(_paths.size());
+    _entries.resize(numPaths);
+
+    // Keep the chain of entries whose subtrees are still open.  Since the
+    // paths are sorted, once a path is not under an open entry no later path
+    // is either, so that entry's subtree ends there.
+    TfSmallVector<uint32_t, 32> open;
+    for (uint32_t i = 0; i != numPaths; ++i) {
+        const SdfPath &path = _paths[i];
+        const uint32_t depth =
+            static_cast<uint32_t>(path.GetPathElementCount());
+        while (!open.empty()) {
+            const uint32_t top = open.back();
+            if (depth > _entries[top].depth && path.HasPrefix(_paths[top])) {
+                break;
+            }
+            _entries[top].subtreeEnd = i;
+            open.pop_back();
+        }
+        _entries[i] = { open.empty() ? _NoIndex : open.back(), 0, depth };
+        open.push_back(i);
+    }
+    for (const uint32_t index: open) {
+        _entries[index].subtreeEnd = numPaths;
+    }
+}
+
+size_t
+SdfPathSortedSet::_LowerBound(SdfPath const &path) const
+{
+    return std::distance(
+        _paths.begin(), std::lower_bound(_paths.begin(), _paths.end(), path));
+}
+
+size_t
+SdfPathSortedSet::Find(SdfPath const &path) const
+{
+    const size_t index = _LowerBound(path);
+    return index != _paths.size() && _paths[index] == path ? index : npos;
+}
+
+size_t
+SdfPathSortedSet::_FindPrefixFrom(size_t index, SdfPath const &path) const
+{
+    if (path.HasPrefix(_paths[index])) {
+        return index;
+    }
+
+    // Any path in the set that is a prefix of \p path sorts before it, and so
+    // at or before \p index, and everything between them is in its subtree.
+    // So the longest such prefix is the nearest ancestor of \p index that is
+    // no deeper than the common prefix of the two paths, which the recorded
+    // depths find without comparing paths.
+    const size_t commonDepth =
+        path.GetCommonPrefix(_paths[index]).GetPathElementCount();
+    uint32_t parent = _entries[index].parent;
+    while (parent != _NoIndex && _entries[parent].depth > commonDepth) {
+        parent = _entries[parent].parent;
+    }
+
+    // The final check only fails when \p path and the set mix absolute and
+    // relative paths, which have no common prefix at all.
+    if (parent != _NoIndex && path.HasPrefix(_paths[parent])) {
+        return parent;
+    }
+    return npos;
+}
+
+size_t
+SdfPathSortedSet::FindLongestPrefix(SdfPath const &path) const
+{
+    const size_t index = _LowerBound(path);
+    if (index != _paths.size() && _paths[index] == path) {
+        return index;
+    }
+    return index == 0 ? npos : _FindPrefixFrom(index - 1, path);
+}
+
+size_t
+SdfPathSortedSet::FindLongestStrictPrefix(SdfPath const &path) const
+{
+    const size_t index = _LowerBound(path);
+    if (index != _paths.size() && _paths[index] == path) {
+        return GetParentIndex(index);
+    }
+    return index == 0 ? npos : _FindPrefixFrom(index - 1, path);
+}
+
+std::pair<size_t, size_t>
+SdfPathSortedSet::FindSubtreeRange(SdfPath const &prefix) const
+{
+    const size_t begin = _LowerBound(prefix);
+
+    // If \p prefix is in the set its subtree is the whole range.  Otherwise
+    // the range is a run of sibling subtrees, so skip over each one.
+    if (begin != _paths.size() && _paths[begin] == prefix) {
+        return { begin, _entries[begin].subtreeEnd };
+    }
+    size_t end = begin;
+    while (end != _paths.size() && _paths[end].HasPrefix(prefix)) {
+        end = _entries[end].subtreeEnd;
+    }
+    return { begin, end };
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::_Select(std::vector<bool> const &keep) const
+{
+    const size_t numPaths = _paths.size();
+
+    // Number the kept entries, with one extra slot so that a subtree that
+    // runs to the end maps to the end.
+    std::vector<uint32_t> newIndex(numPaths + 1);
+    uint32_t numKept = 0;
+    for (size_t i = 0; i != numPaths; ++i) {
+        newIndex[i] = numKept;
+        numKept += keep[i];
+    }
+    newIndex[numPaths] = numKept;
+
+    SdfPathSortedSet result;
+    result._paths.reserve(numKept);
+    result._entries.reserve(numKept);
+    for (size_t i = 0; i != numPaths; ++i) {
+        if (!keep[i]) {
+            continue;
+        }
+        // The kept descendants of an entry are exactly the kept entries in
+        // its old subtree.  Its new parent is its nearest kept ancestor.
+        _Entry const &entry = _entries[i];
+        uint32_t parent = entry.parent;
+        while (parent != _NoIndex && !keep[parent]) {
+            parent = _entries[parent].parent;
+        }
+        result._paths.push_back(_paths[i]);
+        result._entries.push_back({
+            parent == _NoIndex ? _NoIndex : newIndex[parent],
+            newIndex[entry.subtreeEnd], entry.depth });
+    }
+    return result;
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::GetRoots() const
+{
+    std::vector<bool> keep(_paths.size(), false);
+    for (size_t i = 0; i != _paths.size(); i = _entries[i].subtreeEnd) {
+        keep[i] = true;
+    }
+    return _Select(keep);
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::GetLeaves() const
+{
+    std::vector<bool> keep(_paths.size(), false);
+    for (size_t i = 0; i != _paths.size(); ++i) {
+        if (_entries[i].subtreeEnd == i + 1) {
+            keep[i] = true;
+        }
+    }
+    return _Select(keep);
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::GetPathsWithPrefixIn(SdfPathSortedSet const &prefixes) const
+{
+    TRACE_FUNCTION();
+
+    // Only the roots of \p prefixes matter; the rest are inside their
+    // subtrees.
+    std::vector<bool> keep(_paths.size(), false);
+    for (size_t i = 0; i != prefixes.size(); i = prefixes.GetSubtreeEnd(i)) {
+        const std::pair<size_t, size_t> range =
+            FindSubtreeRange(prefixes[i]);
+        std::fill(keep.begin() + range.first, keep.begin() + range.second,
+                  true);
+    }
+    return _Select(keep);
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::GetPathsWithoutPrefixIn(
+    SdfPathSortedSet const &prefixes) const
+{
+    TRACE_FUNCTION();
+
+    std::vector<bool> keep(_paths.size(), true);
+    for (size_t i = 0; i != prefixes.size(); i = prefixes.GetSubtreeEnd(i)) {
+        const std::pair<size_t, size_t> range =
+            FindSubtreeRange(prefixes[i]);
+        std::fill(keep.begin() + range.first, keep.begin() + range.second,
+                  false);
+    }
+    return _Select(keep);
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::Union(SdfPathSortedSet const &lhs,
+                        SdfPathSortedSet const &rhs)
+{
+    TRACE_FUNCTION();
+
+    if (lhs.empty()) {
+        return rhs;
+    }
+    if (rhs.empty()) {
+        return lhs;
+    }
+
+    SdfPathVector paths;
+    paths.reserve(lhs.size() + rhs.size());
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                   std::back_inserter(paths));
+    return FromSorted(std::move(paths));
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::Intersection(SdfPathSortedSet const &lhs,
+                               SdfPathSortedSet const &rhs)
+{
+    TRACE_FUNCTION();
+
+    // The result is a subset of lhs, so select from it rather than
+    // rebuilding the index.
+    std::vector<bool> keep(lhs.size(), false);
+    for (size_t i = 0, j = 0; i != lhs.size() && j != rhs.size(); ) {
+        if (lhs[i] < rhs[j]) {
+            ++i;
+        }
+        else if (rhs[j] < lhs[i]) {
+            ++j;
+        }
+        else {
+            keep[i++] = true;
+            ++j;
+        }
+    }
+    return lhs._Select(keep);
+}
+
+SdfPathSortedSet
+SdfPathSortedSet::Difference(SdfPathSortedSet const &lhs,
+                             SdfPathSortedSet const &rhs)
+{
+    TRACE_FUNCTION();
+
+    std::vector<bool> keep(lhs.size(), false);
+    size_t i = 0;
+    for (size_t j = 0; i != lhs.size() && j != rhs.size(); ) {
+        if (lhs[i] < rhs[j]) {
+            keep[i++] = true;
+        }
+        else if (rhs[j] < lhs[i]) {
+            ++j;
+        }
+        else {
+            ++i;
+            ++j;
+        }
+    }
+    std::fill(keep.begin() + i, keep.end(), true);
+    return lhs._Select(keep);
+}
+
+SDF_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,236 @@
+#ifndef PXR_SDF_PATH_SORTED_SET_H
+#define PXR_SDF_PATH_SORTED_SET_H
+
+#include "pxr/sdf/pxr.h"
+#include "pxr/sdf/api.h"
+#include "pxr/sdf/path.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+SDF_NAMESPACE_OPEN_SCOPE
+
+/// \class SdfPathSortedSet
+///
+/// An immutable, sorted set of paths that also records how the paths nest.
+///
+/// The paths are kept in a contiguous vector in SdfPath::operator< order, so
+/// every path is immediately followed by the paths in the set that have it as
+/// a prefix.  Alongside each path the set stores its element count, the index
+/// of its nearest ancestor in the set and the index one past its last
+/// descendant in the set.  The paths themselves share their prefixes through
+/// the path node tree, so an entry costs one SdfPath plus three integers.
+///
+/// With that index the prefix queries that code otherwise answers with
+/// SdfPathFindLongestPrefix() and SdfPathFindPrefixedRange() over a
+/// std::set<SdfPath> need one binary search and then walk only the recorded
+/// ancestor chain instead of comparing paths again, and GetRoots() and
+/// GetLeaves() (the equivalents of SdfPath::RemoveDescendentPaths() and
+/// SdfPath::RemoveAncestorPaths()) need no comparisons at all.
+///
+/// The set is built in bulk from a range of paths, or by combining two sets
+/// with Union(), Intersection(), Difference(), GetPathsWithPrefixIn() and
+/// GetPathsWithoutPrefixIn(), each a single linear merge.  There is no single
+/// path insertion; collect paths into a vector and construct a set instead.
+///
+class SdfPathSortedSet
+{
+public:
+    using value_type = SdfPath;
+    using size_type = size_t;
+    using const_iterator = SdfPathVector::const_iterator;
+    using iterator = const_iterator;
+
+    /// Returned by the index queries when there is no such entry.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// Construct an empty set.
+    SdfPathSortedSet() = default;
+
+    /// Construct a set of \p paths, which need not be sorted or unique.
+    SDF_API
+    explicit SdfPathSortedSet(SdfPathVector paths);
+
+    /// Construct a set of the paths in [\p first, \p last).
+    template <class Iter>
+    SdfPathSortedSet(Iter first, Iter last)
+        : SdfPathSortedSet(SdfPathVector(first, last)) {}
+
+    /// Construct a set of the paths in \p paths.
+    SdfPathSortedSet(std::initializer_list<SdfPath> paths)
+        : SdfPathSortedSet(SdfPathVector(paths)) {}
+
+    /// Construct a set from \p paths, which must already be sorted and
+    /// unique, as produced by iterating a std::set<SdfPath> or another
+    /// SdfPathSortedSet.  This skips the sort.
+    SDF_API
+    static SdfPathSortedSet FromSorted(SdfPathVector paths);
+
+    /// \name Container
+    /// @{
+
+    const_iterator begin() const { return _paths.begin(); }
+    const_iterator end() const { return _paths.end(); }
+
+    size_t size() const { return _paths.size(); }
+    bool empty() const { return _paths.empty(); }
+
+    /// Return the path at \p index, where paths are numbered in order.
+    SdfPath const &operator[](size_t index) const { return _paths[index]; }
+
+    /// Return the sorted paths.
+    SdfPathVector const &GetPaths() const { return _paths; }
+
+    /// Remove all paths.
+    SDF_API
+    void clear();
+
+    void swap(SdfPathSortedSet &other) {
+        _paths.swap(other._paths);
+        _entries.swap(other._entries);
+    }
+
+    friend void swap(SdfPathSortedSet &lhs, SdfPathSortedSet &rhs) {
+        lhs.swap(rhs);
+    }
+
+    bool operator==(SdfPathSortedSet const &other) const {
+        return _paths == other._paths;
+    }
+    bool operator!=(SdfPathSortedSet const &other) const {
+        return !(*this == other);
+    }
+
+    /// @}
+
+    /// \name Structure
+    /// @{
+
+    /// Return the index of \p path, or npos if it is not in the set.
+    SDF_API
+    size_t Find(SdfPath const &path) const;
+
+    /// Return true if \p path is in the set.
+    bool Contains(SdfPath const &path) const {
+        return Find(path) != npos;
+    }
+
+    /// Return the index of the nearest strict ancestor of the path at
+    /// \p index that is in the set, or npos if there is none.
+    size_t GetParentIndex(size_t index) const {
+        const uint32_t parent = _entries[index].parent;
+        return parent == _NoIndex ? npos : parent;
+    }
+
+    /// Return the index one past the last path in the set that has the path
+    /// at \p index as a prefix.  The paths in [index, GetSubtreeEnd(index))
+    /// are exactly the paths in the set prefixed by the path at \p index.
+    size_t GetSubtreeEnd(size_t index) const {
+        return _entries[index].subtreeEnd;
+    }
+
+    /// Return the element count of the path at \p index, as
+    /// SdfPath::GetPathElementCount() would.
+    size_t GetDepth(size_t index) const {
+        return _entries[index].depth;
+    }
+
+    /// @}
+
+    /// \name Prefix queries
+    /// @{
+
+    /// Return the index of the path in the set that is the longest prefix of
+    /// \p path, including \p path itself, or npos if there is none.
+    SDF_API
+    size_t FindLongestPrefix(SdfPath const &path) const;
+
+    /// Return the index of the path in the set that is the longest prefix of
+    /// \p path, excluding \p path itself, or npos if there is none.
+    SDF_API
+    size_t FindLongestStrictPrefix(SdfPath const &path) const;
+
+    /// Return true if the set contains \p path or any of its ancestors.
+    bool ContainsPrefixOf(SdfPath const &path) const {
+        return FindLongestPrefix(path) != npos;
+    }
+
+    /// Return the half-open index range of the paths in the set that have
+    /// \p prefix as a prefix, including \p prefix itself.
+    SDF_API
+    std::pair<size_t, size_t> FindSubtreeRange(SdfPath const &prefix) const;
+
+    /// @}
+
+    /// \name Bulk operations
+    /// @{
+
+    /// Return the paths in the set that have no ancestor in the set.  This
+    /// is the result of SdfPath::RemoveDescendentPaths() on the paths.
+    SDF_API
+    SdfPathSortedSet GetRoots() const;
+
+    /// Return the paths in the set that have no descendant in the set.  This
+    /// is the result of SdfPath::RemoveAncestorPaths() on the paths.
+    SDF_API
+    SdfPathSortedSet GetLeaves() const;
+
+    /// Return the paths in the set that have a prefix in \p prefixes.
+    SDF_API
+    SdfPathSortedSet
+    GetPathsWithPrefixIn(SdfPathSortedSet const &prefixes) const;
+
+    /// Return the paths in the set that have no prefix in \p prefixes.
+    SDF_API
+    SdfPathSortedSet
+    GetPathsWithoutPrefixIn(SdfPathSortedSet const &prefixes) const;
+
+    /// Return the paths in either \p lhs or \p rhs.
+    SDF_API
+    static SdfPathSortedSet
+    Union(SdfPathSortedSet const &lhs, SdfPathSortedSet const &rhs);
+
+    /// Return the paths in both \p lhs and \p rhs.
+    SDF_API
+    static SdfPathSortedSet
+    Intersection(SdfPathSortedSet const &lhs, SdfPathSortedSet const &rhs);
+
+    /// Return the paths in \p lhs that are not in \p rhs.
+    SDF_API
+    static SdfPathSortedSet
+    Difference(SdfPathSortedSet const &lhs, SdfPathSortedSet const &rhs);
+
+    /// @}
+
+private:
+    static constexpr uint32_t _NoIndex = static_cast<uint32_t>(-1);
+
+    struct _Entry {
+        uint32_t parent;
+        uint32_t subtreeEnd;
+        uint32_t depth;
+    };
+
+    // Fill _entries from _paths, which must be sorted and unique.
+    void _BuildIndex();
+
+    // Return the index of the first path not less than \p path.
+    size_t _LowerBound(SdfPath const &path) const;
+
+    // Return the entries for which \p keep is true, with their structure.
+    SdfPathSortedSet _Select(std::vector<bool> const &keep) const;
+
+    // Return the nearest ancestor of the entry at \p index, or \p index
+    // itself, that is a prefix of \p path.  The entry at \p index must be the
+    // greatest entry not greater than \p path.
+    size_t _FindPrefixFrom(size_t index, SdfPath const &path) const;
+
+    SdfPathVector _paths;
+    std::vector<_Entry> _entries;
+};
+
+SDF_NAMESPACE_CLOSE_SCOPE
+
+#endif // PXR_SDF_PATH_SORTED_SET_H
@@ -7,9 +7,20 @@
 
 #include "pxr/sdf/pxr.h"
 #include "pxr/sdf/pathTable.h"
+#include "pxr/sdf/integerCoding.h"
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+#include <pxr/tf/fastCompression.h>
 #include <pxr/tf/pyLock.h>
+#include <pxr/tf/safeOutputFile.h>
+#include <pxr/trace/trace.h>
 #include <pxr/work/loops.h>
 
+#include <atomic>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+
 SDF_NAMESPACE_OPEN_SCOPE
 
 void
@@ -31,4 +42,445 @@ Sdf_VisitPathTableInParallel(void **entryStart, size_t numEntries,
         });
 }
 
+void
+Sdf_ParallelForPathTable(size_t numEntries,
+                         TfFunctionRef<void(size_t, size_t)> const loopFn)
+{
+    // As above, release the GIL in case loopFn takes it.
+    TF_PY_ALLOW_THREADS_IN_SCOPE();
+
+    WorkParallelForN(numEntries, loopFn);
+}
+
+namespace {
+
+// Path table snapshot files are laid out as:
+//
+//   _SnapshotHeader
+//   value type name          (typeNameSize bytes)
+//   token characters         (uint64 size, uint64 compressed size, data)
+//   element token indexes    (uint64 compressed size, data)
+//   parent offsets           (uint64 compressed size, data)
+//   values                   (numPaths * valueSize bytes)
+//
+// Entries are in table iteration order.  An entry's element token index is 0
+// for the absolute root, the token index plus one for an element appended with
+// AppendElementToken, and its negation for a prim property name.  An entry's
+// parent offset is its index minus its parent's index.  All integers are in
+// native byte order.
+
+constexpr char _SnapshotMagic[8] = { 'S', 'd', 'f', 'P', 'T', 'b', 'l', 'S' };
+constexpr uint32_t _SnapshotVersion = 1;
+
+// LZ4, which TfFastCompression uses, cannot expand its input by more than
+// this factor, so larger sizes recorded in a snapshot must be corrupt.
+constexpr uint64_t _MaxDecompressionRatio = 255;
+
+struct _SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t valueSize;
+    uint64_t numPaths;
+    uint64_t numTokens;
+    uint64_t typeNameSize;
+};
+
+void
+_Append(std::vector<char> *out, void const *data, size_t size)
+{
+    char const *bytes = static_cast<char const *>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
+template <class Int>
+void
+_AppendCompressedInts(std::vector<char> *out, std::vector<Int> const &ints)
+{
+    std::unique_ptr<char[]> buf(
+        new char[Sdf_IntegerCompression::GetCompressedBufferSize(
+                ints.size())]);
+    const uint64_t size = Sdf_IntegerCompression::CompressToBuffer(
+        ints.data(), ints.size(), buf.get());
+    _Append(out, &size, sizeof(size));
+    _Append(out, buf.get(), size);
+}
+
+// Bounds-checked sequential reads from a mapped snapshot.
+class _SnapshotReader
+{
+public:
+    _SnapshotReader(char const *data, size_t size)
+        : _cur(data), _end(data + size) {}
+
+    size_t GetRemaining() const {
+        return static_cast<size_t>(_end - _cur);
+    }
+
+    char const *Take(size_t size) {
+        if (size > static_cast<size_t>(_end - _cur)) {
+            return nullptr;
+        }
+        char const *result = _cur;
+        _cur += size;
+        return result;
+    }
+
+    template <class T>
+    bool Read(T *value) {
+        char const *data = Take(sizeof(T));
+        if (data) {
+            memcpy(value, data, sizeof(T));
+        }
+        return data != nullptr;
+    }
+
+    template <class Int>
+    bool ReadCompressedInts(std::vector<Int> *ints, size_t numInts) {
+        uint64_t size = 0;
+        if (!Read(&size)) {
+            return false;
+        }
+        char const *data = Take(size);
+        if (!data) {
+            return false;
+        }
+        ints->resize(numInts);
+        return numInts == 0 ||
+            Sdf_IntegerCompression::DecompressFromBuffer(
+                data, size, ints->data(), numInts) == numInts;
+    }
+
+private:
+    char const *_cur;
+    char const *_end;
+};
+
+} // anon
+
+bool
+Sdf_WritePathTableSnapshot(std::string const &filePath,
+                           SdfPathVector const &paths,
+                           void const *values, size_t valueSize,
+                           std::string const &valueTypeName)
+{
+    TRACE_FUNCTION();
+
+    const size_t numPaths = paths.size();
+    if (numPaths >= static_cast<size_t>(INT32_MAX)) {
+        TF_CODING_ERROR("Too many paths (%zu) for a path table snapshot",
+                        numPaths);
+        return false;
+    }
+
+    // Find each entry's parent among the entries before it, and intern the
+    // element tokens.
+    std::vector<int32_t> elementTokenIndexes(numPaths);
+    std::vector<uint32_t> parentOffsets(numPaths);
+    std::unordered_map<TfToken, int32_t, TfToken::HashFunctor> tokenIndexes;
+    std::vector<char> tokenChars;
+    std::vector<uint32_t> open;
+    for (size_t i = 0; i != numPaths; ++i) {
+        SdfPath const &path = paths[i];
+        if (i == 0) {
+            if (path != SdfPath::AbsoluteRootPath()) {
+                TF_CODING_ERROR("Path table snapshot must start at the "
+                                "absolute root path, not <%s>",
+                                path.GetText());
+                return false;
+            }
+            open.push_back(0);
+            continue;
+        }
+
+        const SdfPath parentPath = path.GetParentPath();
+        while (!open.empty() && paths[open.back()] != parentPath) {
+            open.pop_back();
+        }
+        if (open.empty()) {
+            TF_CODING_ERROR("Path <%s> does not follow its parent in path "
+                            "table snapshot", path.GetText());
+            return false;
+        }
+        parentOffsets[i] = static_cast<uint32_t>(i - open.back());
+        open.push_back(static_cast<uint32_t>(i));
+
+        const bool isPrimPropertyPath = path.IsPrimPropertyPath();
+        TfToken const &token = isPrimPropertyPath ?
+            path.GetNameToken() : path.GetElementToken();
+        const auto iresult = tokenIndexes.emplace(
+            token, static_cast<int32_t>(tokenIndexes.size()));
+        if (iresult.second) {
+            std::string const &str = token.GetString();
+            tokenChars.insert(
+                tokenChars.end(), str.c_str(), str.c_str() + str.size() + 1);
+        }
+        elementTokenIndexes[i] = isPrimPropertyPath ?
+            -(iresult.first->second + 1) : iresult.first->second + 1;
+    }
+
+    std::vector<char> out;
+    _SnapshotHeader header;
+    memcpy(header.magic, _SnapshotMagic, sizeof(header.magic));
+    header.version = _SnapshotVersion;
+    header.valueSize = static_cast<uint32_t>(valueSize);
+    header.numPaths = numPaths;
+    header.numTokens = tokenIndexes.size();
+    header.typeNameSize = valueTypeName.size();
+    _Append(&out, &header, sizeof(header));
+    _Append(&out, valueTypeName.data(), valueTypeName.size());
+
+    // Token characters, compressed as usdc files do.
+    const uint64_t tokenCharsSize = tokenChars.size();
+    std::unique_ptr<char[]> compressed(
+        new char[TfFastCompression::GetCompressedBufferSize(
+                tokenCharsSize)]);
+    const uint64_t compressedSize = tokenCharsSize == 0 ? 0 :
+        TfFastCompression::CompressToBuffer(
+            tokenChars.data(), compressed.get(), tokenCharsSize);
+    _Append(&out, &tokenCharsSize, sizeof(tokenCharsSize));
+    _Append(&out, &compressedSize, sizeof(compressedSize));
+    _Append(&out, compressed.get(), compressedSize);
+
+    _AppendCompressedInts(&out, elementTokenIndexes);
+    _AppendCompressedInts(&out, parentOffsets);
+    _Append(&out, values, numPaths * valueSize);
+
+    TfErrorMark mark;
+    TfSafeOutputFile outputFile = TfSafeOutputFile::Replace(filePath);
+    if (!mark.IsClean()) {
+        return false;
+    }
+    if (fwrite(out.data(), 1, out.size(), outputFile.Get()) != out.size()) {
+        TF_RUNTIME_ERROR("Failed to write path table snapshot to '%s'",
+                         filePath.c_str());
+        outputFile.Discard();
+        return false;
+    }
+    outputFile.Close();
+    return mark.IsClean();
+}
+
+bool
+Sdf_ReadPathTableSnapshot(std::string const &filePath,
+                          size_t valueSize,
+                          std::string const &valueTypeName,
+                          Sdf_PathTableSnapshot *snapshot)
+{
+    TRACE_FUNCTION();
+
+    std::string errMsg;
+    snapshot->mapping = ArchMapFileReadOnly(filePath, &errMsg);
+    if (!snapshot->mapping) {
+        TF_RUNTIME_ERROR("Failed to map path table snapshot '%s': %s",
+                         filePath.c_str(), errMsg.c_str());
+        return false;
+    }
+
+    const auto corrupt = [&filePath](char const *what) {
+        TF_RUNTIME_ERROR("Corrupt path table snapshot '%s' (%s)",
+                         filePath.c_str(), what);
+        return false;
+    };
+
+    _SnapshotReader reader(
+        snapshot->mapping.get(),
+        ArchGetFileMappingLength(snapshot->mapping));
+
+    _SnapshotHeader header;
+    if (!reader.Read(&header) ||
+        memcmp(header.magic, _SnapshotMagic, sizeof(header.magic)) != 0) {
+        TF_RUNTIME_ERROR("'%s' is not a path table snapshot",
+                         filePath.c_str());
+        return false;
+    }
+    if (header.version != _SnapshotVersion) {
+        TF_RUNTIME_ERROR("Unsupported path table snapshot version %u in '%s'",
+                         header.version, filePath.c_str());
+        return false;
+    }
+    char const *typeName = reader.Take(header.typeNameSize);
+    if (!typeName) {
+        return corrupt("value type");
+    }
+    if (header.valueSize != valueSize ||
+        std::string(typeName, header.typeNameSize) != valueTypeName) {
+        TF_RUNTIME_ERROR("Path table snapshot '%s' holds values of type '%s', "
+                         "not '%s'", filePath.c_str(),
+                         std::string(typeName, header.typeNameSize).c_str(),
+                         valueTypeName.c_str());
+        return false;
+    }
+    // Every path has a value in the file, so the path count is bounded by
+    // the size of the mapping.  Check this before sizing anything by it.
+    if (header.numPaths >= static_cast<uint64_t>(INT32_MAX) ||
+        header.numPaths > reader.GetRemaining() / valueSize) {
+        return corrupt("path count");
+    }
+    const size_t numPaths = header.numPaths;
+
+    // Tokens.
+    uint64_t tokenCharsSize = 0, compressedSize = 0;
+    char const *compressed = nullptr;
+    if (!reader.Read(&tokenCharsSize) || !reader.Read(&compressedSize) ||
+        !(compressed = reader.Take(compressedSize))) {
+        return corrupt("tokens");
+    }
+    // Each token has at least its terminating null, and every token is used
+    // by a path.
+    if (tokenCharsSize > compressedSize * _MaxDecompressionRatio ||
+        header.numTokens > tokenCharsSize || header.numTokens > numPaths) {
+        return corrupt("token count");
+    }
+    std::unique_ptr<char[]> tokenChars(new char[tokenCharsSize + 1]);
+    if (tokenCharsSize != 0 &&
+        TfFastCompression::DecompressFromBuffer(
+            compressed, tokenChars.get(), compressedSize, tokenCharsSize)
+        != tokenCharsSize) {
+        return corrupt("tokens");
+    }
+    tokenChars[tokenCharsSize] = '\0';
+    TfTokenVector tokens;
+    tokens.reserve(header.numTokens);
+    for (char const *p = tokenChars.get(),
+             *end = tokenChars.get() + tokenCharsSize; p < end; ) {
+        tokens.emplace_back(p);
+        p += strlen(p) + 1;
+    }
+    if (tokens.size() != header.numTokens) {
+        return corrupt("token count");
+    }
+
+    // Structure.
+    std::vector<int32_t> elementTokenIndexes;
+    std::vector<uint32_t> parentOffsets;
+    if (!reader.ReadCompressedInts(&elementTokenIndexes, numPaths) ||
+        !reader.ReadCompressedInts(&parentOffsets, numPaths)) {
+        return corrupt("structure");
+    }
+
+    snapshot->values = reader.Take(numPaths * valueSize);
+    if (!snapshot->values) {
+        return corrupt("values");
+    }
+
+    // Check that the parents describe a preorder, with each entry's parent
+    // on the chain of open ancestors, and find where each subtree ends.
+    std::vector<uint32_t> &parents = snapshot->parents;
+    std::vector<uint32_t> &subtreeEnds = snapshot->subtreeEnds;
+    parents.resize(numPaths);
+    subtreeEnds.resize(numPaths);
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i != numPaths; ++i) {
+        const int32_t tokenIndex = elementTokenIndexes[i];
+        if (i == 0) {
+            if (tokenIndex != 0 || parentOffsets[i] != 0) {
+                return corrupt("root");
+            }
+            parents[i] = uint32_t(-1);
+            open.push_back(i);
+            continue;
+        }
+        // Widen before negating, since -INT32_MIN does not fit an int32_t.
+        const int64_t tokenNumber =
+            tokenIndex < 0 ? -int64_t(tokenIndex) : int64_t(tokenIndex);
+        if (tokenNumber == 0 ||
+            static_cast<uint64_t>(tokenNumber) > tokens.size() ||
+            parentOffsets[i] == 0 || parentOffsets[i] > i) {
+            return corrupt("entry");
+        }
+        parents[i] = i - parentOffsets[i];
+        while (!open.empty() && open.back() != parents[i]) {
+            subtreeEnds[open.back()] = i;
+            open.pop_back();
+        }
+        if (open.empty()) {
+            return corrupt("parent");
+        }
+        open.push_back(i);
+    }
+    for (const uint32_t i: open) {
+        subtreeEnds[i] = static_cast<uint32_t>(numPaths);
+    }
+
+    // Build the paths.  Each path depends only on its parent, so build the
+    // top of the tree until there are enough subtrees, then build those in
+    // parallel.
+    SdfPathVector &paths = snapshot->paths;
+    paths.resize(numPaths);
+    if (numPaths == 0) {
+        return true;
+    }
+    std::atomic<bool> failed { false };
+    const auto buildPath = [&](uint32_t i) {
+        SdfPath const &parentPath = paths[parents[i]];
+        const int64_t tokenIndex = elementTokenIndexes[i];
+        paths[i] = tokenIndex < 0 ?
+            parentPath.AppendProperty(tokens[-tokenIndex - 1]) :
+            parentPath.AppendElementToken(tokens[tokenIndex - 1]);
+        // An element token may spell more than one element, or none, so
+        // make sure the path really is a child of its recorded parent.
+        if (paths[i].IsEmpty() || paths[i].GetParentPath() != parentPath) {
+            failed = true;
+        }
+    };
+
+    paths[0] = SdfPath::AbsoluteRootPath();
+    std::vector<uint32_t> frontier { 0 };
+    while (frontier.size() < 256) {
+        std::vector<uint32_t> next;
+        for (const uint32_t f: frontier) {
+            for (uint32_t c = f + 1; c != subtreeEnds[f]; c = subtreeEnds[c]) {
+                buildPath(c);
+                next.push_back(c);
+            }
+        }
+        if (next.empty()) {
+            break;
+        }
+        frontier.swap(next);
+    }
+    WorkParallelForN(
+        frontier.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t f = begin; f != end; ++f) {
+                const uint32_t root = frontier[f];
+                for (uint32_t i = root + 1; i != subtreeEnds[root]; ++i) {
+                    buildPath(i);
+                }
+            }
+        });
+
+    if (failed) {
+        return corrupt("path elements");
+    }
+
+    // A path may only appear once, and since every path is a child of its
+    // recorded parent, any repeat is among some entry's children.
+    WorkParallelForN(
+        numPaths,
+        [&](size_t begin, size_t end) {
+            std::unordered_set<SdfPath, SdfPath::Hash> children;
+            for (size_t f = begin; f != end && !failed; ++f) {
+                const uint32_t first = static_cast<uint32_t>(f) + 1;
+                if (first == subtreeEnds[f] ||
+                    subtreeEnds[first] == subtreeEnds[f]) {
+                    // At most one child.
+                    continue;
+                }
+                children.clear();
+                for (uint32_t c = first; c != subtreeEnds[f];
+                     c = subtreeEnds[c]) {
+                    if (!children.insert(paths[c]).second) {
+                        failed = true;
+                        break;
+                    }
+                }
+            }
+        });
+    if (failed) {
+        return corrupt("duplicate paths");
+    }
+    return true;
+}
+
 SDF_NAMESPACE_CLOSE_SCOPE
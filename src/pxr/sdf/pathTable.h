@@ -13,8 +13,15 @@
 #include "pxr/sdf/path.h"
 #include <pxr/tf/pointerAndBits.h>
 #include <pxr/tf/functionRef.h>
+#include <pxr/arch/demangle.h>
+#include <pxr/arch/fileSystem.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -24,6 +31,34 @@ SDF_NAMESPACE_OPEN_SCOPE
 SDF_API
 void Sdf_VisitPathTableInParallel(void **, size_t, TfFunctionRef<void(void*&)>);
 
+// Parallel loop helper function, used by SdfPathTable::InsertMany.
+SDF_API
+void Sdf_ParallelForPathTable(size_t, TfFunctionRef<void(size_t, size_t)>);
+
+// The decoded contents of a path table snapshot file.  Paths are in table
+// iteration order, each with the index of its parent (-1 for the root) and
+// the index one past its last descendant.  Values point into the mapping.
+struct Sdf_PathTableSnapshot {
+    SdfPathVector paths;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> subtreeEnds;
+    ArchConstFileMapping mapping;
+    char const *values = nullptr;
+};
+
+// Snapshot helper functions, used by SdfPathTable::WriteSnapshot and
+// SdfPathTable::ReadSnapshot.
+SDF_API
+bool Sdf_WritePathTableSnapshot(std::string const &filePath,
+                                SdfPathVector const &paths,
+                                void const *values, size_t valueSize,
+                                std::string const &valueTypeName);
+SDF_API
+bool Sdf_ReadPathTableSnapshot(std::string const &filePath,
+                               size_t valueSize,
+                               std::string const &valueTypeName,
+                               Sdf_PathTableSnapshot *snapshot);
+
 /// \class SdfPathTable
 ///
 /// A mapping from SdfPath to \a MappedType, somewhat similar to map<SdfPath,
@@ -62,6 +97,14 @@ void Sdf_VisitPathTableInParallel(void **, size_t, TfFunctionRef<void(void*&)>);
 /// elements with paths prefixed by \a p, a call to erase(\a i) may invalidate
 /// many iterators.
 ///
+/// Entry Storage
+///
+/// Entries added by insert() are allocated individually.  Entries added by
+/// InsertMany() are instead constructed together in one block, laid out in
+/// iteration order, so iterating over a subtree added that way, as with
+/// FindSubtreeRange(), walks contiguous memory.  Erasing such an entry
+/// destroys it in place; its block is freed by clear() or the destructor.
+///
 template <class MappedType>
 class SdfPathTable
 {
@@ -80,54 +123,76 @@ private:
     struct _Entry {
         _Entry(const _Entry&) = delete;
         _Entry& operator=(const _Entry&) = delete;
-        _Entry(value_type const &value, _Entry *n)
+        // The bits stored in nextSiblingOrParent.
+        static constexpr unsigned IsSiblingBit = 1;
+        static constexpr unsigned InBlockBit = 2;
+
+        _Entry(value_type const &value, _Entry *n, bool inBlock = false)
             : value(value)
             , next(n)
             , firstChild(nullptr)
-            , nextSiblingOrParent(nullptr, false) {}
+            , nextSiblingOrParent(nullptr, inBlock ? InBlockBit : 0u) {}
 
-        _Entry(value_type &&value, _Entry *n)
+        _Entry(value_type &&value, _Entry *n, bool inBlock = false)
             : value(std::move(value))
             , next(n)
             , firstChild(nullptr)
-            , nextSiblingOrParent(nullptr, false) {}
+            , nextSiblingOrParent(nullptr, inBlock ? InBlockBit : 0u) {}
+
+        // Return true if this entry's nextSiblingOrParent field points to a
+        // sibling rather than a parent.
+        bool HasNextSibling() const {
+            return nextSiblingOrParent.template BitsAs<unsigned>() &
+                IsSiblingBit;
+        }
+
+        // Return true if this entry lives in one of the table's entry blocks
+        // rather than in its own allocation.
+        bool IsInBlock() const {
+            return nextSiblingOrParent.template BitsAs<unsigned>() &
+                InBlockBit;
+        }
 
         // If this entry's nextSiblingOrParent field points to a sibling, return
         // a pointer to it, otherwise return null.
         _Entry *GetNextSibling() {
-            return nextSiblingOrParent.template BitsAs<bool>() ?
-                nextSiblingOrParent.Get() : 0;
+            return HasNextSibling() ? nextSiblingOrParent.Get() : 0;
         }
         // If this entry's nextSiblingOrParent field points to a sibling, return
         // a pointer to it, otherwise return null.
         _Entry const *GetNextSibling() const {
-            return nextSiblingOrParent.template BitsAs<bool>() ?
-                nextSiblingOrParent.Get() : 0;
+            return HasNextSibling() ? nextSiblingOrParent.Get() : 0;
         }
 
         // If this entry's nextSiblingOrParent field points to a parent, return
         // a pointer to it, otherwise return null.
         _Entry *GetParentLink() {
-            return nextSiblingOrParent.template BitsAs<bool>() ? 0 :
-                nextSiblingOrParent.Get();
+            return HasNextSibling() ? 0 : nextSiblingOrParent.Get();
         }
         // If this entry's nextSiblingOrParent field points to a parent, return
         // a pointer to it, otherwise return null.
         _Entry const *GetParentLink() const {
-            return nextSiblingOrParent.template BitsAs<bool>() ? 0 :
-                nextSiblingOrParent.Get();
+            return HasNextSibling() ? 0 : nextSiblingOrParent.Get();
+        }
+
+        // Set this entry's nextSiblingOrParent field to point to \a entry,
+        // which is a sibling if \a isSibling is true and a parent otherwise.
+        void SetSiblingOrParent(_Entry *entry, bool isSibling) {
+            nextSiblingOrParent.Set(
+                entry, (IsInBlock() ? InBlockBit : 0u) |
+                (isSibling ? IsSiblingBit : 0u));
         }
 
         // Set this entry's nextSiblingOrParent field to point to the passed
         // sibling.
         void SetSibling(_Entry *sibling) {
-            nextSiblingOrParent.Set(sibling, /* isSibling */ true);
+            SetSiblingOrParent(sibling, /* isSibling */ true);
         }
 
         // Set this entry's nextSiblingOrParent field to point to the passed
         // parent.
         void SetParentLink(_Entry *parent) {
-            nextSiblingOrParent.Set(parent, /* isSibling */ false);
+            SetSiblingOrParent(parent, /* isSibling */ false);
         }
 
         // Add \a child as a child of this entry.
@@ -153,7 +218,8 @@ private:
                     prev = cur;
                     cur = prev->GetNextSibling();
                 } while (cur != child);
-                prev->nextSiblingOrParent = cur->nextSiblingOrParent;
+                prev->SetSiblingOrParent(
+                    cur->nextSiblingOrParent.Get(), cur->HasNextSibling());
             }
         }
 
@@ -168,16 +234,25 @@ private:
         // firstChild is non null.  Its chlidren are stored in a singly linked
         // list, where nextSiblingOrParent points to the next entry in the list.
         //
-        // The end of the list is reached when the bit stored in
-        // nextSiblingOrParent is set false, indicating a pointer to the parent
-        // rather than another sibling.
+        // The end of the list is reached when the IsSiblingBit stored in
+        // nextSiblingOrParent is clear, indicating a pointer to the parent
+        // rather than another sibling.  The InBlockBit is set if this entry
+        // lives in one of the table's entry blocks rather than in its own
+        // allocation.
         _Entry *firstChild;
         TfPointerAndBits<_Entry> nextSiblingOrParent;
     };
 
+    static_assert(TfPointerAndBits<_Entry>::GetMaxValue() >=
+                  (_Entry::IsSiblingBit | _Entry::InBlockBit),
+                  "_Entry is not aligned enough to hold its link bits");
+
     // Hash table's list of buckets is a vector of _Entry ptrs.
     typedef std::vector<_Entry *> _BucketVec;
 
+    // Blocks of entries allocated by InsertMany, with their capacities.
+    typedef std::vector<std::pair<_Entry *, size_t>> _BlockVec;
+
 public:
 
     // The iterator class, used to make both const and non-const 
@@ -400,10 +475,10 @@ public:
             // Ensure the nextSibling/parentLink is created.
             if (i._entry->nextSiblingOrParent.Get() &&  
                 !j._entry->nextSiblingOrParent.Get()) {
-                j._entry->nextSiblingOrParent.Set(
+                j._entry->SetSiblingOrParent(
                     _InsertInTable(i._entry->nextSiblingOrParent.
                                    Get()->value).first._entry,
-                    i._entry->nextSiblingOrParent.template BitsAs<bool>());
+                    i._entry->HasNextSibling());
             }
         }
     }
@@ -411,6 +486,7 @@ public:
     /// Move constructor.
     SdfPathTable(SdfPathTable &&other)
         : _buckets(std::move(other._buckets))
+        , _blocks(std::move(other._blocks))
         , _size(other._size)
         , _mask(other._mask)
     {
@@ -597,6 +673,104 @@ public:
         return insert(value_type(path, mapped_type())).first->second;
     }
 
+    /// Insert default entries for all of \a sortedPaths, and for all of their
+    /// ancestral paths, that do not already exist in the table.  Return the
+    /// number of entries added.
+    ///
+    /// \a sortedPaths must be absolute paths sorted by SdfPath::operator<;
+    /// duplicates are allowed.  This finds where the new entries go in a
+    /// single pass over the paths, then constructs them in one block in
+    /// iteration order and links them into the tree in parallel.  This
+    /// requires that default-constructing \a mapped_type is thread-safe.
+    size_t InsertMany(SdfPathVector const &sortedPaths) {
+        TfAutoMallocTag2 tag2("Sdf", "SdfPathTable::InsertMany");
+        TfAutoMallocTag tag(__ARCH_PRETTY_FUNCTION__);
+
+        TF_DEV_AXIOM(std::is_sorted(sortedPaths.begin(), sortedPaths.end()));
+
+        std::vector<_PendingEntry> pending;
+        _CollectPendingEntries(sortedPaths, &pending);
+        if (pending.empty()) {
+            return 0;
+        }
+        _InsertPendingEntries(pending, [](size_t) { return mapped_type(); });
+        return pending.size();
+    }
+
+    /// Write this table's paths and values to a snapshot file at
+    /// \a filePath, which ReadSnapshot() can load much faster than the table
+    /// can be rebuilt.  Return true on success, or issue an error and return
+    /// false.
+    ///
+    /// Paths are stored as a token table plus per-entry element and parent
+    /// offsets, compressed like the paths in usdc files.  Values are stored
+    /// as raw bytes, so \a mapped_type must be trivially copyable and the
+    /// snapshot is only readable on machines with the same value layout.
+    bool WriteSnapshot(std::string const &filePath) const {
+        static_assert(std::is_trivially_copyable<mapped_type>::value,
+                      "Path table snapshots require trivially copyable "
+                      "mapped values");
+
+        SdfPathVector paths;
+        std::vector<char> values(_size * sizeof(mapped_type));
+        paths.reserve(_size);
+        char *value = values.data();
+        for (const_iterator i = begin(), e = end(); i != e; ++i) {
+            paths.push_back(i->first);
+            memcpy(value, &i->second, sizeof(mapped_type));
+            value += sizeof(mapped_type);
+        }
+        return Sdf_WritePathTableSnapshot(
+            filePath, paths, values.data(), sizeof(mapped_type),
+            ArchGetDemangled<mapped_type>());
+    }
+
+    /// Replace this table's contents with the snapshot at \a filePath, as
+    /// written by WriteSnapshot() for a table with the same \a mapped_type.
+    /// The file is mapped, its paths are rebuilt in parallel and the entries
+    /// are constructed in one block, as InsertMany() does.  Return true on
+    /// success, or issue an error, leave the table unchanged and return
+    /// false.
+    bool ReadSnapshot(std::string const &filePath) {
+        static_assert(std::is_trivially_copyable<mapped_type>::value,
+                      "Path table snapshots require trivially copyable "
+                      "mapped values");
+        TfAutoMallocTag2 tag2("Sdf", "SdfPathTable::ReadSnapshot");
+        TfAutoMallocTag tag(__ARCH_PRETTY_FUNCTION__);
+
+        Sdf_PathTableSnapshot snapshot;
+        if (!Sdf_ReadPathTableSnapshot(
+                filePath, sizeof(mapped_type),
+                ArchGetDemangled<mapped_type>(), &snapshot)) {
+            return false;
+        }
+
+        clear();
+        const size_t numPaths = snapshot.paths.size();
+        if (numPaths == 0) {
+            return true;
+        }
+
+        std::vector<_PendingEntry> pending(numPaths);
+        for (size_t i = 0; i != numPaths; ++i) {
+            _PendingEntry &entry = pending[i];
+            entry.path = std::move(snapshot.paths[i]);
+            entry.parent = snapshot.parents[i] == uint32_t(-1) ?
+                static_cast<size_t>(-1) : snapshot.parents[i];
+            entry.existingParent = nullptr;
+            entry.subtreeEnd = snapshot.subtreeEnds[i];
+        }
+
+        char const * const values = snapshot.values;
+        _InsertPendingEntries(pending, [values](size_t i) {
+            mapped_type value;
+            memcpy(&value, values + i * sizeof(mapped_type),
+                   sizeof(mapped_type));
+            return value;
+        });
+        return true;
+    }
+
     /// Remove all elements from the table, leaving size() == 0.  Note that this
     /// function will not shrink the number of buckets used for the hash table.
     /// To do that, swap this instance with a default constructed instance.
@@ -607,12 +781,13 @@ public:
             _Entry *entry = _buckets[i];
             while (entry) {
                 _Entry *next = entry->next;
-                delete entry;
+                _DeleteEntry(entry);
                 entry = next;
             }
             _buckets[i] = 0;
         }
         _size = 0;
+        _FreeBlocks();
     }
 
     /// Equivalent to clear(), but destroy contained objects in parallel.  This
@@ -623,7 +798,7 @@ public:
                 _Entry *entry = static_cast<_Entry *>(voidEntry);
                 while (entry) {
                     _Entry *next = entry->next;
-                    delete entry;
+                    _DeleteEntry(entry);
                     entry = next;
                 }
                 voidEntry = nullptr;
@@ -631,11 +806,13 @@ public:
         Sdf_VisitPathTableInParallel(reinterpret_cast<void **>(_buckets.data()),
                                      _buckets.size(), visitFn);
         _size = 0;
+        _FreeBlocks();
     }        
 
     /// Swap this table's contents with \a other.
     void swap(SdfPathTable &other) {
         _buckets.swap(other._buckets);
+        _blocks.swap(other._blocks);
         std::swap(_size, other._size);
         std::swap(_mask, other._mask);
     }
@@ -790,7 +967,169 @@ private:
         --_size;
         _Entry *tmp = *cur;
         *cur = tmp->next;
-        delete tmp;
+        _DeleteEntry(tmp);
+    }
+
+    // Destroy \a entry, and free it unless it lives in an entry block.
+    static void _DeleteEntry(_Entry *entry) {
+        if (entry->IsInBlock()) {
+            entry->~_Entry();
+        } else {
+            delete entry;
+        }
+    }
+
+    // Free the entry blocks.  Their entries must already be destroyed.
+    void _FreeBlocks() {
+        std::allocator<_Entry> alloc;
+        for (std::pair<_Entry *, size_t> const &block: _blocks) {
+            alloc.deallocate(block.first, block.second);
+        }
+        _blocks.clear();
+    }
+
+    // An entry that InsertMany will add, with the index of its parent among
+    // the pending entries, or its existing parent entry in the table, and the
+    // index one past its last pending descendant.
+    struct _PendingEntry {
+        SdfPath path;
+        size_t parent;
+        _Entry *existingParent;
+        size_t subtreeEnd;
+    };
+
+    // Find the entries that InsertMany must add for \a sortedPaths, in
+    // iteration order, and how they attach to each other and to the table.
+    void _CollectPendingEntries(SdfPathVector const &sortedPaths,
+                                std::vector<_PendingEntry> *pending) const {
+        static const size_t npos = static_cast<size_t>(-1);
+
+        // The chain of paths from the root to the last path visited, each
+        // either already in the table or pending.
+        struct _Open {
+            SdfPath path;
+            _Entry *existing;
+            size_t pendingIndex;
+        };
+        std::vector<_Open> open;
+        SdfPathVector missing;
+
+        const auto close = [&pending](_Open const &o) {
+            if (o.pendingIndex != npos) {
+                (*pending)[o.pendingIndex].subtreeEnd = pending->size();
+            }
+        };
+
+        for (SdfPath const &path: sortedPaths) {
+            if (!path.IsAbsolutePath()) {
+                TF_CODING_ERROR("Cannot insert non-absolute path <%s>",
+                                path.GetText());
+                continue;
+            }
+
+            // Leave the subtrees that do not contain this path.  Since the
+            // paths are sorted, they will not be entered again.
+            while (!open.empty() && !path.HasPrefix(open.back().path)) {
+                close(open.back());
+                open.pop_back();
+            }
+            if (!open.empty() && open.back().path == path) {
+                continue;
+            }
+
+            // Walk up from the path until reaching the open chain or an
+            // entry already in the table.  All of that entry's ancestors are
+            // in the table too.
+            missing.clear();
+            _Entry *existing = nullptr;
+            for (SdfPath p = path; !p.IsEmpty(); p = _GetParentPath(p)) {
+                if (!open.empty() && p == open.back().path) {
+                    break;
+                }
+                const const_iterator iter = find(p);
+                if (iter != end()) {
+                    existing = const_cast<_Entry *>(iter._entry);
+                    open.push_back({ p, existing, npos });
+                    break;
+                }
+                missing.push_back(p);
+            }
+
+            // Add the missing paths top-down.
+            for (auto it = missing.rbegin(); it != missing.rend(); ++it) {
+                _PendingEntry entry { *it, npos, nullptr, 0 };
+                if (!open.empty()) {
+                    entry.parent = open.back().pendingIndex;
+                    entry.existingParent = open.back().existing;
+                }
+                open.push_back({ *it, nullptr, pending->size() });
+                pending->push_back(std::move(entry));
+            }
+        }
+        while (!open.empty()) {
+            close(open.back());
+            open.pop_back();
+        }
+    }
+
+    // Construct \a pending in a new entry block, with the mapped value of
+    // entry \a i given by \a makeMapped(i), and add them to the table.
+    template <class MakeMappedFn>
+    void _InsertPendingEntries(std::vector<_PendingEntry> const &pending,
+                               MakeMappedFn const &makeMapped) {
+        const size_t numPending = pending.size();
+
+        while (_mask == 0 || _size + numPending > _buckets.size()) {
+            _Grow();
+        }
+
+        _Entry * const block = std::allocator<_Entry>().allocate(numPending);
+        _blocks.emplace_back(block, numPending);
+
+        // Construct the entries and link their tree structure.  An entry's
+        // first child, if any, immediately follows it, and its next sibling,
+        // if any, immediately follows its subtree.
+        Sdf_ParallelForPathTable(
+            numPending,
+            [block, numPending, &pending, &makeMapped](
+                size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    _Entry *entry = new (block + i) _Entry(
+                        value_type(pending[i].path, makeMapped(i)),
+                        nullptr, /* inBlock */ true);
+                    if (i + 1 != numPending && pending[i + 1].parent == i) {
+                        entry->firstChild = block + i + 1;
+                    }
+                    const size_t parent = pending[i].parent;
+                    if (parent == static_cast<size_t>(-1)) {
+                        // Linked into an existing parent below.
+                        continue;
+                    }
+                    const size_t sibling = pending[i].subtreeEnd;
+                    if (sibling != numPending &&
+                        pending[sibling].parent == parent) {
+                        entry->SetSibling(block + sibling);
+                    } else {
+                        entry->SetParentLink(block + parent);
+                    }
+                }
+            });
+
+        // Attach the entries whose parents were already in the table, in
+        // reverse so that they keep their order among the parent's children.
+        for (size_t i = numPending; i--; ) {
+            if (_Entry * const parent = pending[i].existingParent) {
+                parent->AddChild(block + i);
+            }
+        }
+
+        // Add the entries to the hash table.
+        for (size_t i = 0; i != numPending; ++i) {
+            _Entry *&bucketHead = _buckets[_Hash(pending[i].path)];
+            block[i].next = bucketHead;
+            bucketHead = block + i;
+        }
+        _size += numPending;
     }
 
     // Erase all the tree structure descendants of \a entry from the table.
@@ -879,6 +1218,7 @@ private:
 
 private:
     _BucketVec _buckets;
+    _BlockVec _blocks;
     size_t _size;
     size_t _mask;
 
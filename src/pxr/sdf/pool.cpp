@@ -6,9 +6,17 @@
 // Modified by Jeremy Retailleau.
 
 #include "pxr/sdf/pxr.h"
+#include <pxr/arch/defines.h>
+#include <pxr/arch/systemInfo.h>
 #include <pxr/arch/virtualMemory.h>
 #include "pxr/sdf/pool.h"
 
+#if defined(ARCH_OS_WINDOWS)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
 SDF_NAMESPACE_OPEN_SCOPE
 
 char *
@@ -23,4 +31,28 @@ Sdf_PoolCommitRange(char *start, char *end)
     return ArchCommitVirtualMemoryRange(start, end-start);
 }
 
+size_t
+Sdf_PoolReleaseRange(char *start, char *end)
+{
+    // Only whole pages can be released, so trim the range to page boundaries.
+    const uintptr_t pageMask = ArchGetPageSize() - 1;
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(start) + pageMask)
+        & ~pageMask;
+    const uintptr_t last = reinterpret_cast<uintptr_t>(end) & ~pageMask;
+    if (first >= last) {
+        return 0;
+    }
+    void *addr = reinterpret_cast<void *>(first);
+    const size_t numBytes = last - first;
+#if defined(ARCH_OS_WINDOWS)
+    // The span is committed again before it is reused.
+    const bool released = VirtualFree(addr, numBytes, MEM_DECOMMIT) != 0;
+#else
+    // Unlike posix_madvise, madvise with MADV_DONTNEED drops the pages right
+    // away; they read back as zeros when touched again.
+    const bool released = madvise(addr, numBytes, MADV_DONTNEED) == 0;
+#endif
+    return released ? numBytes : 0;
+}
+
 SDF_NAMESPACE_CLOSE_SCOPE
@@ -19,7 +19,9 @@
 
 #include <tbb/concurrent_queue.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <thread>
 
 SDF_NAMESPACE_OPEN_SCOPE
@@ -42,6 +44,25 @@ struct Sdf_FastThreadLocalBase
     }
 };
 
+// Statistics describing the state of an Sdf_Pool.  See Sdf_Pool::GetStats().
+struct Sdf_PoolStats
+{
+    // Elements handed out to threads that are not on a shared free list.  This
+    // is an upper bound on the number of live elements, since it includes
+    // elements on per-thread free lists and in per-thread spans not yet
+    // allocated from.
+    size_t liveElements = 0;
+    // Elements on the shared free lists.
+    size_t freeListElements = 0;
+    // Bytes of virtual address space reserved for regions.
+    size_t reservedBytes = 0;
+    // Bytes committed for spans, less those released to the system.
+    size_t committedBytes = 0;
+    // Bytes released to the system by ReleaseUnusedMemory() and not yet
+    // reused.
+    size_t releasedBytes = 0;
+};
+
 // Fixed-size scalable pool allocator with 32-bit "handles" returned.  Reserves
 // virtual memory in big regions.  It's optimized for per-thread allocations,
 // and intended to be used for SdfPath.  The Tag template argument just serves
@@ -55,7 +76,9 @@ struct Sdf_FastThreadLocalBase
 // to hold ElemsPerSpan elements from the range, then uses that to dole out
 // individual allocations.  When freed, allocations are placed on a thread-local
 // free list, and eventually shared back for use by other threads when the free
-// list gets large.
+// list gets large.  ReleaseUnusedMemory() returns the memory of spans whose
+// elements are all on shared free lists to the system, and GetStats() reports
+// occupancy for diagnostics.
 template <class Tag,
           unsigned ElemSize,
           unsigned RegionBits,
@@ -203,6 +226,21 @@ public:
     static inline Handle Allocate();
     static inline void Free(Handle h);
 
+    // Return the memory of spans whose elements are all free and on shared
+    // free lists to the system, and set those spans aside to be handed out
+    // again before new space is reserved.  Elements on per-thread free lists
+    // keep their spans resident.  Return the number of bytes released.
+    //
+    // If clients read elements without holding them, e.g. through stale
+    // handles, pass \p waitForReaders.  It is called once the spans to release
+    // are chosen and before their memory is returned, and must wait until no
+    // thread can still be reading their elements.
+    SDF_API static size_t ReleaseUnusedMemory(
+        void (*waitForReaders)() = nullptr);
+
+    // Return occupancy and memory statistics for this pool.
+    SDF_API static Sdf_PoolStats GetStats();
+
 private:
 
     // Given a region id and index, form the pointer into the pool.
@@ -243,15 +281,35 @@ private:
 
     // Try to take a shared free list.
     static bool _TakeSharedFreeList(_FreeList &out) {
-        return _sharedFreeLists->try_pop(out);
+        if (_sharedFreeLists->try_pop(out)) {
+            _counters.sharedFree.fetch_sub(
+                out.size, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
     }
     
     // Give a free list to be shared by other threads.
     static void _ShareFreeList(_FreeList &in) {
+        _counters.sharedFree.fetch_add(in.size, std::memory_order_relaxed);
         _sharedFreeLists->push(in);
         in = {};
     }
 
+    // Return the span that holds the element \p h.  Spans are reserved in
+    // ElemsPerSpan-sized pieces starting at index 1 in each region, and the
+    // last span in a region ends at MaxIndex.
+    static inline _PoolSpan _GetSpanFor(Handle h) {
+        _PoolSpan span;
+        span.region = h.value & RegionMask;
+        span.beginIndex =
+            (((h.value >> RegionBits) - 1) / ElemsPerSpan) * ElemsPerSpan + 1;
+        span.endIndex = static_cast<uint32_t>(
+            std::min<uint64_t>(
+                uint64_t(span.beginIndex) + ElemsPerSpan, MaxIndex));
+        return span;
+    }
+
     // Reserve a new span of pool space.
     static inline void _ReserveSpan(_PoolSpan &out);
 
@@ -262,6 +320,25 @@ private:
     SDF_API static char *_regionStarts[NumRegions+1];
     SDF_API static std::atomic<_RegionState> _regionState;
     SDF_API static TfStaticData<tbb::concurrent_queue<_FreeList>> _sharedFreeLists;
+
+    // Spans whose memory was returned to the system by ReleaseUnusedMemory(),
+    // with the number of bytes actually released for each.
+    struct _ReleasedSpan {
+        _PoolSpan span;
+        size_t numBytes;
+    };
+    SDF_API static TfStaticData<tbb::concurrent_queue<_ReleasedSpan>>
+    _releasedSpans;
+
+    // Pool-wide counters, updated once per span or shared free list rather
+    // than once per element so they stay off the allocation fast path.
+    struct _Counters {
+        std::atomic<size_t> handedOut { 0 };
+        std::atomic<size_t> sharedFree { 0 };
+        std::atomic<size_t> committedBytes { 0 };
+        std::atomic<size_t> releasedBytes { 0 };
+    };
+    SDF_API static _Counters _counters;
 };
 
 SDF_NAMESPACE_CLOSE_SCOPE
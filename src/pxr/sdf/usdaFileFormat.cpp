@@ -54,6 +54,12 @@ TF_DEFINE_ENV_SETTING(
     " equal minor and patch versions. This is only for new files; saving"
     " edits to an existing file preserves its version.");
 
+TF_DEFINE_ENV_SETTING(
+    SDF_USDA_INCREMENTAL_SAVE, false,
+    "When saving a usda layer, keep the text written for each root prim in "
+    "memory and reuse it on later saves for root prims that have not been "
+    "edited since.");
+
 TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
 
@@ -316,7 +322,8 @@ _WriteLayer(
     Sdf_TextOutput& out,
     const string& cookie,
     const SdfFileVersion& version,
-    const string& commentOverride)
+    const string& commentOverride,
+    Sdf_RootPrimTextCache* rootPrimTextCache = nullptr)
 {
     TRACE_FUNCTION();
 
@@ -416,7 +423,31 @@ _WriteLayer(
     // Root prims
     for (const SdfPrimSpecHandle& rootPrim : l->GetRootPrims()) {
         _Write(out, 0,"\n");
-        Sdf_WritePrim(rootPrim.GetSpec(), out, 0);
+
+        if (!rootPrimTextCache) {
+            Sdf_WritePrim(rootPrim.GetSpec(), out, 0);
+            continue;
+        }
+
+        // Reuse the text from the last save if the prim has not changed,
+        // otherwise write it and remember the text.
+        const TfToken& name = rootPrim->GetNameToken();
+        auto cached = rootPrimTextCache->entries.find(name);
+        if (cached == rootPrimTextCache->entries.end()) {
+            Sdf_RootPrimTextCache::Entry entry;
+            out.BeginCapture(&entry.text);
+            Sdf_WritePrim(rootPrim.GetSpec(), out, 0);
+            out.EndCapture(&entry.requiredVersion, &entry.upgradeReason);
+            rootPrimTextCache->entries.emplace(name, std::move(entry));
+        }
+        else {
+            const Sdf_RootPrimTextCache::Entry& entry = cached->second;
+            if (entry.requiredVersion) {
+                out.RequestWriteVersionUpgrade(
+                    entry.requiredVersion, entry.upgradeReason);
+            }
+            out.Write(entry.text);
+        }
     }
 
     _Write(out, 0,"\n");
@@ -482,11 +513,16 @@ SdfUsdaFileFormat::SaveToFile(
 
     Sdf_TextOutput out(std::move(asset), filePath);
 
+    Sdf_RootPrimTextCache* rootPrimTextCache =
+        TfGetEnvSetting(SDF_USDA_INCREMENTAL_SAVE) ?
+        _GetRootPrimTextCache(layer) : nullptr;
+
     const bool ok = _WriteLayer(&layer,
                                 out,
                                 GetFileCookie(),
                                 outVersion,
-                                comment);
+                                comment,
+                                rootPrimTextCache);
 
     if (ok && !out.Close()) {
         TF_RUNTIME_ERROR("Could not close %s", filePath.c_str());
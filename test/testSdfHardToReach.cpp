@@ -7,6 +7,7 @@
 
 #include <pxr/sdf/pxr.h>
 #include <pxr/sdf/attributeSpec.h>
+#include <pxr/sdf/changeBlock.h>
 #include <pxr/sdf/changeManager.h>
 #include <pxr/sdf/layer.h>
 #include <pxr/sdf/notice.h>
@@ -16,9 +17,17 @@
 #include <pxr/sdf/reference.h>
 #include <pxr/sdf/relationshipSpec.h>
 #include <pxr/sdf/schema.h>
-
+#include <pxr/sdf/types.h>
+#include <pxr/tf/errorMark.h>
+#include <pxr/tf/getenv.h>
+#include <pxr/tf/stringUtils.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <map>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 SDF_NAMESPACE_USING_DIRECTIVE
@@ -70,6 +79,199 @@ static void _CompareChangeLists(
     TF_AXIOM(actualClStr.str() == expectedClStr.str());
 }
 
+static void
+_TestSdfChangeListCompactionRenames(SdfChangeList::Options const &options)
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous();
+    SdfPrimSpecHandle geo = SdfCreatePrimInLayer(layer, SdfPath("/Root/Geo"));
+    SdfPrimSpecHandle item = SdfCreatePrimInLayer(layer, SdfPath("/Src/Item"));
+
+    SdfChangeBlock block(options);
+    for (int i = 0; i != 20; ++i) {
+        SdfPrimSpec::New(geo, TfStringPrintf("Mesh_%d", i), SdfSpecifierDef);
+    }
+
+    // Moving a prim into the collapsed subtree is absorbed by it, but its
+    // removal from its old parent is still recorded.
+    TF_AXIOM(geo->InsertNameChild(item));
+
+    // Renaming the collapsed prefix moves the collapse with it, so that a
+    // new prim at the old path records its own changes.
+    TF_AXIOM(geo->SetName("Moved", /* validate = */ true));
+    SdfPrimSpecHandle newGeo =
+        SdfCreatePrimInLayer(layer, SdfPath("/Root/Geo/Child"));
+    TF_AXIOM(newGeo);
+
+    const SdfChangeList cl =
+        Sdf_ChangeManager::Get().ExtractLocalChanges(layer);
+
+    TF_AXIOM(cl.GetEntry(SdfPath("/Src")).flags.didChangeSubtree);
+    const SdfChangeList::Entry &moved = cl.GetEntry(SdfPath("/Root/Moved"));
+    TF_AXIOM(moved.flags.didRename);
+    TF_AXIOM(moved.flags.didChangeSubtree);
+    TF_AXIOM(moved.oldPath == SdfPath("/Root/Geo"));
+    TF_AXIOM(cl.FindEntry(SdfPath("/Root/Geo/Child")) !=
+             cl.GetEntryList().end());
+    for (const auto &pathAndEntry : cl.GetEntryList()) {
+        TF_AXIOM(pathAndEntry.first == SdfPath("/Root/Moved") ||
+                 !pathAndEntry.first.HasPrefix(SdfPath("/Root/Moved")));
+    }
+}
+
+static void
+_TestSdfChangeListCompaction()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous();
+    SdfPrimSpecHandle geo = SdfCreatePrimInLayer(layer, SdfPath("/Root/Geo"));
+    SdfPrimSpecHandle other = SdfCreatePrimInLayer(layer, SdfPath("/Other"));
+
+    SdfChangeList::Options options;
+    options.compactionThreshold = 8;
+    options.captureInfoValues = false;
+
+    SdfChangeBlock block(options);
+    for (int i = 0; i != 100; ++i) {
+        SdfPrimSpecHandle mesh = SdfPrimSpec::New(
+            geo, TfStringPrintf("Mesh_%d", i), SdfSpecifierDef);
+        SdfAttributeSpec::New(mesh, "points", SdfValueTypeNames->Point3fArray);
+    }
+    other->SetDocumentation("doc");
+
+    const SdfChangeList cl =
+        Sdf_ChangeManager::Get().ExtractLocalChanges(layer);
+
+    // Everything beneath /Root/Geo is collapsed into a single entry.
+    TF_AXIOM(cl.GetEntry(SdfPath("/Root/Geo")).flags.didChangeSubtree);
+    TF_AXIOM(!cl.GetEntry(SdfPath("/Root")).flags.didChangeSubtree);
+    for (const auto &pathAndEntry : cl.GetEntryList()) {
+        TF_AXIOM(pathAndEntry.first == SdfPath("/Root/Geo") ||
+                 !pathAndEntry.first.HasPrefix(SdfPath("/Root/Geo")));
+    }
+
+    // Info changes are recorded without values.
+    const SdfChangeList::Entry &otherEntry = cl.GetEntry(SdfPath("/Other"));
+    const auto docChange =
+        otherEntry.FindInfoChange(SdfFieldKeys->Documentation);
+    TF_AXIOM(docChange != otherEntry.infoChanged.end());
+    TF_AXIOM(docChange->second.first.IsEmpty());
+    TF_AXIOM(docChange->second.second.IsEmpty());
+
+    _TestSdfChangeListCompactionRenames(options);
+}
+
+static void
+_TestSdfChangeManagerValueFreeFields()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous();
+    SdfPrimSpecHandle prim = SdfCreatePrimInLayer(layer, SdfPath("/Prim"));
+    SdfPrimSpec::New(prim, "A", SdfSpecifierDef);
+    SdfPrimSpec::New(prim, "B", SdfSpecifierDef);
+    SdfAttributeSpecHandle attr =
+        SdfAttributeSpec::New(prim, "points", SdfValueTypeNames->IntArray);
+    attr->SetDefaultValue(VtValue(VtIntArray(3, 1)));
+
+    SdfChangeList::Options options;
+    options.captureInfoValues = false;
+    {
+        SdfChangeBlock block(options);
+        layer->SetField(attr->GetPath(), SdfFieldKeys->Default,
+                        VtValue(VtIntArray(1024, 2)));
+        layer->SetFieldDictValueByKey(prim->GetPath(),
+                                      SdfFieldKeys->CustomData,
+                                      TfToken("key"), VtValue(1));
+        layer->SetField(prim->GetPath(), SdfChildrenKeys->PrimChildren,
+                        TfTokenVector{TfToken("B"), TfToken("A")});
+
+        const SdfChangeList cl =
+            Sdf_ChangeManager::Get().ExtractLocalChanges(layer);
+
+        // Only the changed keys are recorded.
+        const SdfChangeList::Entry &attrEntry = cl.GetEntry(attr->GetPath());
+        const auto defaultChange =
+            attrEntry.FindInfoChange(SdfFieldKeys->Default);
+        TF_AXIOM(defaultChange != attrEntry.infoChanged.end());
+        TF_AXIOM(defaultChange->second.first.IsEmpty());
+        TF_AXIOM(defaultChange->second.second.IsEmpty());
+
+        const SdfChangeList::Entry &primEntry = cl.GetEntry(prim->GetPath());
+        TF_AXIOM(primEntry.FindInfoChange(SdfFieldKeys->CustomData) !=
+                 primEntry.infoChanged.end());
+
+        // Changes derived from field values are still detected.
+        TF_AXIOM(primEntry.flags.didReorderChildren);
+    }
+
+    // The layer holds the new values.
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(VtIntArray(1024, 2)));
+    TF_AXIOM(layer->GetFieldDictValueByKey(
+        prim->GetPath(), SdfFieldKeys->CustomData, TfToken("key")) ==
+             VtValue(1));
+    TF_AXIOM(prim->GetNameChildren()[0]->GetName() == "B");
+}
+
+static void
+_TestSdfLayerChangeJournal()
+{
+    struct Listener : public TfWeakBase
+    {
+        void LayersDidChange(const SdfNotice::LayersDidChange &n)
+        {
+            serialNumbers.push_back(n.GetSerialNumber());
+        }
+
+        std::vector<size_t> serialNumbers;
+    };
+
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous();
+    TF_AXIOM(layer->GetChangeJournalLimit() == 0);
+
+    std::vector<SdfLayer::ChangeJournalRound> rounds;
+    TF_AXIOM(!layer->GetJournaledChangesSince(0, &rounds));
+
+    Listener listener;
+    TfNotice::Key key = TfNotice::Register(
+        TfCreateWeakPtr(&listener), &Listener::LayersDidChange);
+
+    // Changes made before the journal is enabled are not recorded.
+    SdfCreatePrimInLayer(layer, SdfPath("/Before"));
+    const size_t beforeSerial = listener.serialNumbers.back();
+
+    layer->SetChangeJournalLimit(4);
+    TF_AXIOM(layer->GetChangeJournalLimit() == 4);
+    TF_AXIOM(!layer->GetJournaledChangesSince(beforeSerial - 1, &rounds));
+    TF_AXIOM(layer->GetJournaledChangesSince(beforeSerial, &rounds));
+    TF_AXIOM(rounds.empty());
+
+    SdfCreatePrimInLayer(layer, SdfPath("/A"));
+    SdfCreatePrimInLayer(layer, SdfPath("/B"));
+    const size_t bSerial = listener.serialNumbers.back();
+
+    TF_AXIOM(layer->GetJournaledChangesSince(beforeSerial, &rounds));
+    TF_AXIOM(rounds.size() == 2);
+    TF_AXIOM(rounds[0].second.GetEntry(SdfPath("/A")).flags.didAddInertPrim);
+    TF_AXIOM(rounds[1].first == bSerial);
+    TF_AXIOM(rounds[1].second.GetEntry(SdfPath("/B")).flags.didAddInertPrim);
+
+    // Changes since the most recent round are empty.
+    rounds.clear();
+    TF_AXIOM(layer->GetJournaledChangesSince(bSerial, &rounds));
+    TF_AXIOM(rounds.empty());
+
+    // Older rounds are discarded once the journal exceeds its limit.
+    for (int i = 0; i != 4; ++i) {
+        SdfCreatePrimInLayer(layer, SdfPath(TfStringPrintf("/C_%d", i)));
+    }
+    TF_AXIOM(!layer->GetJournaledChangesSince(beforeSerial, &rounds));
+    TF_AXIOM(layer->GetJournaledChangesSince(
+        listener.serialNumbers.back() - 1, &rounds));
+    TF_AXIOM(rounds.size() == 1);
+
+    layer->SetChangeJournalLimit(0);
+    TF_AXIOM(!layer->GetJournaledChangesSince(bSerial, &rounds));
+
+    TfNotice::Revoke(key);
+}
+
 static void
 _TestSdfLayerCreateDiffChangeListWithoutValues()
 {
@@ -276,6 +478,60 @@ _TestSdfChangeManagerExtractLocalChanges()
     TF_AXIOM(listener.invocations == 1);
 }
 
+static void
+_TestSdfChangeManagerConcurrentPerLayerNotices()
+{
+    struct Listener : public TfWeakBase
+    {
+        void LayersDidChange(const SdfNotice::LayersDidChange &)
+        {
+            ++globalNotices;
+        }
+
+        void LayerDidChange(
+            const SdfNotice::LayersDidChangeSentPerLayerConcurrently &n,
+            const SdfLayerHandle &layer)
+        {
+            // The global notice for the round has already been sent.
+            TF_AXIOM(globalNotices == 1);
+            TF_AXIOM(n.count(layer));
+            ++layerNotices;
+        }
+
+        std::atomic<size_t> globalNotices{0};
+        std::atomic<size_t> layerNotices{0};
+    };
+
+    Listener listener;
+    TfNotice::Key globalKey = TfNotice::Register(
+        TfCreateWeakPtr(&listener), &Listener::LayersDidChange);
+
+    SdfLayerRefPtrVector layers;
+    std::vector<TfNotice::Key> keys;
+    for (int i = 0; i != 64; ++i) {
+        layers.push_back(SdfLayer::CreateAnonymous());
+        keys.push_back(TfNotice::Register(
+            TfCreateWeakPtr(&listener), &Listener::LayerDidChange,
+            SdfLayerHandle(layers.back())));
+    }
+
+    {
+        SdfChangeBlock block;
+        for (const SdfLayerRefPtr &layer : layers) {
+            SdfCreatePrimInLayer(layer, SdfPath("/Prim"));
+        }
+    }
+
+    // The notices are only sent when enabled.
+    TF_AXIOM(listener.globalNotices == 1);
+    TF_AXIOM(listener.layerNotices ==
+             (TfGetenvBool("SDF_CHANGE_MANAGER_CONCURRENT_NOTICES", false) ?
+              layers.size() : 0));
+
+    TfNotice::Revoke(&keys);
+    TfNotice::Revoke(globalKey);
+}
+
 static void
 _TestSdfLayerCreateDiffDiffWithOver()
 {
@@ -310,6 +566,71 @@ _TestSdfLayerCreateDiffDiffWithOver()
 
 }
 
+static void
+_TestSdfLayerCreateDiffNestedChanges()
+{
+    const std::string layerStr = R"(#usda 1.0
+        def "World" {
+            def "A" {
+                int x = 1
+                def "B" {
+                    double y = 2.0
+                    rel r = </World/C>
+                }
+            }
+            def "C" (
+                variantSets = "v"
+            ) {
+                variantSet "v" = {
+                    "one" {
+                        def "D" {
+                            int z = 3
+                        }
+                    }
+                }
+            }
+        }
+    )";
+
+    SdfLayerRefPtr layerA = SdfLayer::CreateAnonymous();
+    layerA->ImportFromString(layerStr);
+    SdfLayerRefPtr layerB = SdfLayer::CreateAnonymous();
+    layerB->ImportFromString(layerStr);
+
+    // Identical layers produce no changes.
+    TF_AXIOM(layerA->CreateDiff(layerB).GetEntryList().empty());
+
+    // A single changed value deep in namespace produces a single entry.
+    layerB->SetField(SdfPath("/World/A/B.y"), SdfFieldKeys->Default,
+                     VtValue(3.0));
+    {
+        SdfChangeList cl = layerA->CreateDiff(layerB);
+        TF_AXIOM(cl.GetEntryList().size() == 1);
+        TF_AXIOM(cl.GetEntryList().front().first == SdfPath("/World/A/B.y"));
+    }
+
+    // Changes inside variants and removed specs are found as well.
+    layerB->SetField(SdfPath("/World/C{v=one}D.z"), SdfFieldKeys->Default,
+                     VtValue(4));
+    SdfCreatePrimInLayer(layerB, SdfPath("/World/E"));
+    {
+        SdfChangeList cl = layerA->CreateDiff(layerB);
+        TF_AXIOM(cl.GetEntry(SdfPath("/World/A/B.y")).infoChanged.size()
+                 == 1);
+        TF_AXIOM(cl.GetEntry(SdfPath("/World/C{v=one}D.z")).infoChanged.size()
+                 == 1);
+        TF_AXIOM(cl.GetEntry(SdfPath("/World/E")).flags.didAddInertPrim);
+        TF_AXIOM(cl.GetEntry(SdfPath("/World/A")).infoChanged.empty());
+    }
+
+    // Setting the data applies every change.
+    layerA->TransferContent(layerB);
+    std::string strA, strB;
+    TF_AXIOM(layerA->ExportToString(&strA));
+    TF_AXIOM(layerB->ExportToString(&strB));
+    TF_AXIOM(strA == strB);
+}
+
 static void
 _TestSdfLayerDictKeyOps()
 {
@@ -397,6 +718,194 @@ _TestSdfLayerTimeSampleValueType()
     TF_AXIOM(value == 4.0);
 }
 
+static void
+_TestSdfLayerMemoryUsage()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous(".usda");
+
+    const SdfAbstractDataMemoryUsage emptyUsage = layer->GetMemoryUsage();
+    TF_AXIOM(emptyUsage.specTableBytes > 0);
+    TF_AXIOM(emptyUsage.timeSampleBytes == 0);
+    TF_AXIOM(emptyUsage.mappedBytes == 0);
+
+    SdfPrimSpecHandle prim = SdfCreatePrimInLayer(layer, SdfPath("/Prim"));
+    prim->SetDocumentation(std::string(1000, 'x'));
+    SdfAttributeSpecHandle points =
+        SdfAttributeSpec::New(prim, "points", SdfValueTypeNames->FloatArray);
+    points->SetDefaultValue(VtValue(VtFloatArray(1000)));
+    SdfAttributeSpecHandle anim =
+        SdfAttributeSpec::New(prim, "anim", SdfValueTypeNames->FloatArray);
+    for (double time = 0.0; time < 10.0; time += 1.0) {
+        layer->SetTimeSample(
+            anim->GetPath(), time, VtValue(VtFloatArray(100)));
+    }
+
+    const SdfAbstractDataMemoryUsage usage = layer->GetMemoryUsage();
+    TF_AXIOM(usage.specTableBytes > emptyUsage.specTableBytes);
+    TF_AXIOM(usage.fieldBytes > emptyUsage.fieldBytes);
+    TF_AXIOM(usage.GetValueBytes() >=
+             1000 + 1000 * sizeof(float) + emptyUsage.GetValueBytes());
+    TF_AXIOM(usage.timeSampleBytes >= 10 * 100 * sizeof(float));
+    TF_AXIOM(usage.mappedBytes == 0);
+    TF_AXIOM(usage.GetTotalBytes() ==
+             usage.specTableBytes + usage.fieldBytes +
+             usage.GetValueBytes() + usage.timeSampleBytes +
+             usage.structuralBytes);
+
+    // A usdc layer also reports the crate file's structural tables.
+    SdfLayerRefPtr crateLayer = SdfLayer::CreateAnonymous(".usdc");
+    crateLayer->TransferContent(layer);
+    const SdfAbstractDataMemoryUsage crateUsage =
+        crateLayer->GetMemoryUsage();
+    TF_AXIOM(crateUsage.specTableBytes > 0);
+    TF_AXIOM(crateUsage.GetValueBytes() >= 1000 * sizeof(float));
+    TF_AXIOM(crateUsage.timeSampleBytes >= 10 * 100 * sizeof(float));
+}
+
+static void
+_TestSdfLayerPageOut()
+{
+    const std::string path = "testSdfLayerPageOut.usdc";
+    {
+        SdfLayerRefPtr source = SdfLayer::CreateAnonymous(".usda");
+        for (int i = 0; i != 10; ++i) {
+            SdfPrimSpecHandle prim = SdfCreatePrimInLayer(
+                source, SdfPath(TfStringPrintf("/Prim_%d", i)));
+            SdfAttributeSpec::New(prim, "value", SdfValueTypeNames->Int)
+                ->SetDefaultValue(VtValue(i));
+        }
+        TF_AXIOM(source->Export(path));
+    }
+
+    SdfLayerRefPtr layer = SdfLayer::FindOrOpen(path);
+    TF_AXIOM(layer);
+    TF_AXIOM(layer->StreamsData());
+    TF_AXIOM(!layer->IsPagedOut());
+
+    SdfAttributeSpecHandle attr =
+        layer->GetAttributeAtPath(SdfPath("/Prim_3.value"));
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+
+    // A clean streaming layer can be paged out, and is reopened on the next
+    // access through existing handles.
+    TF_AXIOM(layer->PageOut());
+    TF_AXIOM(layer->IsPagedOut());
+    TF_AXIOM(layer->StreamsData());
+    TF_AXIOM(layer->GetMemoryUsage().GetTotalBytes() == 0);
+    TF_AXIOM(!layer->PageOut());
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+    TF_AXIOM(!layer->IsPagedOut());
+    TF_AXIOM(layer->GetRootPrims().size() == 10);
+
+    // Dirty and anonymous layers are never paged out.
+    attr->SetDefaultValue(VtValue(42));
+    TF_AXIOM(layer->IsDirty());
+    TF_AXIOM(!layer->PageOut());
+    TF_AXIOM(!SdfLayer::CreateAnonymous(".usdc")->PageOut());
+    TF_AXIOM(layer->Reload(/* force = */ true));
+    TF_AXIOM(!layer->IsDirty());
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+
+    // With no memory budget every clean streaming layer is paged out, and a
+    // budget that covers the layer leaves it resident.
+    const SdfAbstractDataMemoryUsage usage = layer->GetMemoryUsage();
+    TF_AXIOM(SdfLayer::PageOutLayers(
+                 usage.GetTotalBytes() + usage.mappedBytes) == 0);
+    TF_AXIOM(!layer->IsPagedOut());
+    TF_AXIOM(SdfLayer::PageOutLayers(0) >= 1);
+    TF_AXIOM(layer->IsPagedOut());
+    TF_AXIOM(layer->HasSpec(SdfPath("/Prim_9")));
+    TF_AXIOM(!layer->IsPagedOut());
+
+    // A file that changed on disk since it was read is not paged out, since
+    // reopening it might not restore the same contents.  Reloading reads the
+    // new file and makes the layer pageable again.
+    std::filesystem::last_write_time(
+        path, std::filesystem::last_write_time(path) + std::chrono::hours(1));
+    TF_AXIOM(!layer->PageOut());
+    TF_AXIOM(!layer->IsPagedOut());
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+    TF_AXIOM(layer->Reload(/* force = */ true));
+    TF_AXIOM(layer->PageOut());
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+
+    // A file that changes while its layer is paged out is not read back in.
+    // The access that tries reports an error, and the emptied layer refuses
+    // to save over the file even once it is edited.
+    TF_AXIOM(layer->PageOut());
+    std::filesystem::last_write_time(
+        path, std::filesystem::last_write_time(path) + std::chrono::hours(1));
+    {
+        TfErrorMark mark;
+        TF_AXIOM(!layer->HasSpec(SdfPath("/Prim_9")));
+        TF_AXIOM(!mark.IsClean());
+        mark.SetMark();
+        TF_AXIOM(SdfCreatePrimInLayer(layer, SdfPath("/New")));
+        TF_AXIOM(layer->IsDirty());
+        TF_AXIOM(!layer->Save());
+        TF_AXIOM(!layer->Export(path));
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+    TF_AXIOM(!layer->PageOut());
+    TF_AXIOM(layer->Reload(/* force = */ true));
+    TF_AXIOM(layer->HasSpec(SdfPath("/Prim_9")));
+    TF_AXIOM(attr->GetDefaultValue() == VtValue(3));
+    TF_AXIOM(layer->PageOut());
+}
+
+static void
+_TestSdfCrateLayerRoundTrip()
+{
+    // Use a spec count that doesn't divide evenly into the batches that
+    // crate data looks paths up in when it opens and saves a file.
+    const std::string path = "testSdfCrateLayerRoundTrip.usdc";
+    const int numPrims = 1003;
+    {
+        SdfLayerRefPtr source = SdfLayer::CreateAnonymous(".usda");
+        SdfChangeBlock block;
+        for (int i = 0; i != numPrims; ++i) {
+            SdfPrimSpecHandle prim = SdfCreatePrimInLayer(
+                source, SdfPath(TfStringPrintf("/Prim_%d/Child", i)));
+            SdfAttributeSpec::New(prim, "value", SdfValueTypeNames->Int)
+                ->SetDefaultValue(VtValue(i));
+        }
+        TF_AXIOM(source->Export(path));
+    }
+
+    auto verify = [&](SdfLayerHandle const &layer, int offset) {
+        TF_AXIOM(layer->GetRootPrims().size() == size_t(numPrims));
+        for (int i = 0; i != numPrims; ++i) {
+            const SdfPath primPath(TfStringPrintf("/Prim_%d/Child", i));
+            TF_AXIOM(layer->GetSpecType(primPath) == SdfSpecTypePrim);
+            TF_AXIOM(layer->GetSpecType(primPath.GetParentPath()) ==
+                     SdfSpecTypePrim);
+            TF_AXIOM(layer->GetField(
+                         primPath.AppendProperty(TfToken("value")),
+                         SdfFieldKeys->Default) == VtValue(i + offset));
+        }
+        TF_AXIOM(!layer->HasSpec(SdfPath("/Prim_0/Missing")));
+    };
+
+    SdfLayerRefPtr layer = SdfLayer::FindOrOpen(path);
+    TF_AXIOM(layer);
+    verify(layer, 0);
+
+    // Saving packs every spec and then repopulates from the new file.
+    {
+        SdfChangeBlock block;
+        for (int i = 0; i != numPrims; ++i) {
+            layer->SetField(
+                SdfPath(TfStringPrintf("/Prim_%d/Child.value", i)),
+                SdfFieldKeys->Default, VtValue(i + 1));
+        }
+    }
+    TF_AXIOM(layer->Save());
+    verify(layer, 1);
+    TF_AXIOM(layer->Reload(/* force = */ true));
+    verify(layer, 1);
+}
+
 static void
 _TestSdfLayerTransferContentsEmptyLayer()
 {
@@ -605,6 +1114,177 @@ _TestSdfPathFindLongestPrefix()
                  pathMap, SdfPath("/qix"))->first == SdfPath("/"));
 }
 
+static void
+_TestSdfPathBuildTree()
+{
+    const size_t root = SdfPath::TreeRootIndex;
+    const std::vector<size_t> parents = {
+        root, 0, 1, 1, 0, root, 5, 2 };
+    const TfTokenVector names = {
+        TfToken("A"), TfToken("B"), TfToken("C"), TfToken("prop"),
+        TfToken("ns:attr"), TfToken("D"), TfToken("E"), TfToken("F") };
+    const std::vector<bool> isProperty = {
+        false, false, false, true, true, false, false, false };
+
+    SdfPathVector paths = SdfPath::BuildTree(
+        SdfPath::AbsoluteRootPath(), parents, names, isProperty);
+    const SdfPathVector expected = {
+        SdfPath("/A"), SdfPath("/A/B"), SdfPath("/A/B/C"),
+        SdfPath("/A/B.prop"), SdfPath("/A.ns:attr"), SdfPath("/D"),
+        SdfPath("/D/E"), SdfPath("/A/B/C/F") };
+    TF_AXIOM(paths == expected);
+
+    // Without property flags every element is a prim, and the root may be
+    // any prim or variant selection path.
+    paths = SdfPath::BuildTree(
+        SdfPath("/Root{v=x}"), { root, 0 },
+        { TfToken("Child"), TfToken("Grandchild") });
+    TF_AXIOM(paths.size() == 2);
+    TF_AXIOM(paths[0] == SdfPath("/Root{v=x}Child"));
+    TF_AXIOM(paths[1] == SdfPath("/Root{v=x}Child/Grandchild"));
+
+    // Invalid elements produce empty paths like AppendChild does, and so do
+    // their descendants.
+    {
+        TfErrorMark mark;
+        paths = SdfPath::BuildTree(
+            SdfPath::AbsoluteRootPath(), { root, 0, 0, 1 },
+            { TfToken("A"), TfToken("prop"), TfToken("1nvalid"),
+              TfToken("Child") },
+            { false, true, false, false });
+        mark.Clear();
+    }
+    TF_AXIOM(paths.size() == 4);
+    TF_AXIOM(paths[0] == SdfPath("/A"));
+    TF_AXIOM(paths[1] == SdfPath("/A.prop"));
+    TF_AXIOM(paths[2].IsEmpty());
+    TF_AXIOM(paths[3].IsEmpty());
+
+    // Parents must precede their children.
+    {
+        TfErrorMark mark;
+        paths = SdfPath::BuildTree(
+            SdfPath::AbsoluteRootPath(), { 1, root },
+            { TfToken("A"), TfToken("B") });
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+    TF_AXIOM(paths.empty());
+
+    // A wide, deep tree matches paths built one element at a time.
+    std::vector<size_t> wideParents;
+    TfTokenVector wideNames;
+    for (size_t i = 0; i != 5000; ++i) {
+        wideParents.push_back(i < 10 ? root : i / 10);
+        wideNames.push_back(TfToken(TfStringPrintf("N_%zu", i % 17)));
+    }
+    paths = SdfPath::BuildTree(
+        SdfPath::AbsoluteRootPath(), wideParents, wideNames);
+    for (size_t i = 0; i != paths.size(); ++i) {
+        const SdfPath parent = wideParents[i] == root ?
+            SdfPath::AbsoluteRootPath() : paths[wideParents[i]];
+        TF_AXIOM(paths[i] == parent.AppendChild(wideNames[i]));
+    }
+}
+
+static void
+_TestSdfPathPoolRelease()
+{
+    // Enough prim paths to fill several pool spans.
+    const size_t numPaths = 200000;
+    auto makePaths = [numPaths](char const *prefix) {
+        SdfPathVector paths;
+        paths.reserve(numPaths);
+        for (size_t i = 0; i != numPaths; ++i) {
+            paths.push_back(SdfPath::AbsoluteRootPath().AppendChild(
+                TfToken(TfStringPrintf("%s_%zu", prefix, i))));
+        }
+        return paths;
+    };
+
+    {
+        const SdfPathVector paths = makePaths("PoolRelease");
+        const SdfPathPoolStats stats = SdfPathGetPoolStats();
+        TF_AXIOM(stats.liveNodes >= numPaths);
+        TF_AXIOM(stats.committedBytes <= stats.reservedBytes);
+    }
+
+    // With the paths gone, whole spans of nodes are on the shared free lists
+    // and can be returned to the system.
+    const SdfPathPoolStats beforeRelease = SdfPathGetPoolStats();
+    const size_t released = SdfPathReleaseUnusedPoolMemory();
+    const SdfPathPoolStats afterRelease = SdfPathGetPoolStats();
+    TF_AXIOM(released > 0);
+    TF_AXIOM(afterRelease.committedBytes + released ==
+             beforeRelease.committedBytes);
+    TF_AXIOM(afterRelease.releasedBytes ==
+             beforeRelease.releasedBytes + released);
+    TF_AXIOM(afterRelease.freeListNodes < beforeRelease.freeListNodes);
+    TF_AXIOM(afterRelease.reservedBytes == beforeRelease.reservedBytes);
+
+    // Releasing again finds nothing new.
+    TF_AXIOM(SdfPathReleaseUnusedPoolMemory() == 0);
+
+    // New paths reuse the released spans before reserving new space.
+    {
+        const SdfPathVector paths = makePaths("PoolReuse");
+        const SdfPathPoolStats stats = SdfPathGetPoolStats();
+        TF_AXIOM(stats.releasedBytes < afterRelease.releasedBytes);
+        TF_AXIOM(paths[numPaths-1].GetName() ==
+                 TfStringPrintf("PoolReuse_%zu", numPaths-1));
+    }
+}
+
+static void
+_TestSdfPathTokens()
+{
+    // Prim paths with several properties each, some with target paths that
+    // refer to properties on the same prim, which re-enters the token table
+    // while a token is being made.
+    auto makePaths = [](char const *root) {
+        SdfPathVector paths;
+        for (size_t i = 0; i != 2000; ++i) {
+            const SdfPath prim(TfStringPrintf("/%s/Prim_%zu", root, i));
+            paths.push_back(prim);
+            for (size_t j = 0; j != i % 40; ++j) {
+                paths.push_back(prim.AppendProperty(
+                    TfToken(TfStringPrintf("prop_%zu", j))));
+            }
+            paths.push_back(prim.AppendProperty(TfToken("rel"))
+                            .AppendTarget(prim.AppendProperty(
+                                              TfToken("prop_0"))));
+        }
+        return paths;
+    };
+
+    const SdfPathVector paths = makePaths("Tokens");
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t != 8; ++t) {
+        threads.emplace_back([&paths, t]() {
+            for (size_t i = t; i < paths.size() + t; ++i) {
+                SdfPath const &path = paths[i % paths.size()];
+                TfToken const &token = path.GetToken();
+                TF_AXIOM(token == path.GetAsToken());
+                TF_AXIOM(&path.GetToken() == &token);
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+
+    // Tokens for paths that die are dropped and made again on demand.
+    {
+        const SdfPathVector transient = makePaths("Transient");
+        for (SdfPath const &path: transient) {
+            TF_AXIOM(path.GetString() == path.GetAsString());
+        }
+    }
+    for (SdfPath const &path: makePaths("Transient")) {
+        TF_AXIOM(path.GetString() == path.GetAsString());
+    }
+}
+
 static void
 _TestSdfFpsAndTcps()
 {
@@ -906,17 +1586,28 @@ int
 main(int argc, char **argv)
 {
     _TestSdfChangeManagerExtractLocalChanges();
+    _TestSdfChangeListCompaction();
+    _TestSdfChangeManagerValueFreeFields();
+    _TestSdfChangeManagerConcurrentPerLayerNotices();
+    _TestSdfLayerChangeJournal();
     _TestSdfLayerCreateDiffChangeListWithoutValues();
     _TestSdfLayerCreateDiffChangeListWithValues();
     _testSdfLayerCreateDiffTimeSamplesWithValues();
     _testSdfLayerCreateDiffTimeSamplesWithoutValues();
     _TestSdfLayerCreateDiffDiffWithOver();
+    _TestSdfLayerCreateDiffNestedChanges();
     _TestSdfLayerDictKeyOps();
     _TestSdfLayerTimeSampleValueType();
+    _TestSdfLayerMemoryUsage();
+    _TestSdfLayerPageOut();
+    _TestSdfCrateLayerRoundTrip();
     _TestSdfLayerTransferContents();
     _TestSdfLayerTransferContentsEmptyLayer();
     _TestSdfRelationshipTargetSpecEdits();
     _TestSdfPathFindLongestPrefix();
+    _TestSdfPathBuildTree();
+    _TestSdfPathPoolRelease();
+    _TestSdfPathTokens();
     _TestSdfFpsAndTcps();
     _TestSdfSchemaPathValidation();
     _TestSdfMapEditorProxyOperators();
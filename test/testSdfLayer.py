@@ -350,6 +350,67 @@ def "Root" (
                 "Unexpected references {0} at {1}"
                 .format(prim.referenceList, prim.path))
 
+    def test_GetCompositionAssetDependencies(self):
+        srcLayer = Sdf.Layer.CreateAnonymous(".usda")
+        srcLayer.ImportFromString('''\
+#usda 1.0
+(
+    subLayers = [
+        @sublayer_1.usda@,
+        @sublayer_2.usda@
+    ]
+)
+
+def "Root" (
+    payload = @payload_1.usda@</Payload>
+    references = [
+        @ref_1.usda@</Ref>,
+        </Internal>
+    ]
+)
+{
+    def "Child" (
+        prepend references = @ref_2.usda@</Ref>
+        delete references = @deleted.usda@</Ref>
+    )
+    {
+    }
+
+    variantSet "v" = {
+        "x" (
+            payload = @payload_2.usda@</Payload>
+        ) {
+            def "ChildInVariant" (
+                append references = @ref_3.usda@</Ref>
+            )
+            {
+            }
+        }
+    }
+}
+''')
+
+        expected = set([
+            "", "sublayer_1.usda", "sublayer_2.usda",
+            "payload_1.usda", "payload_2.usda",
+            "ref_1.usda", "ref_2.usda", "ref_3.usda"])
+        self.assertEqual(
+            set(srcLayer.GetCompositionAssetDependencies()), expected)
+
+        # Crate layers must report the same dependencies, both as read from
+        # the file and after editing.
+        crateLayer = Sdf.Layer.CreateNew("testCompositionAssetDependencies.usdc")
+        crateLayer.TransferContent(srcLayer)
+        self.assertTrue(crateLayer.Save())
+        self.assertTrue(crateLayer.Reload(force=True))
+        self.assertEqual(
+            set(crateLayer.GetCompositionAssetDependencies()), expected)
+
+        crateLayer.GetPrimAtPath("/Root/Child").referenceList.ClearEdits()
+        self.assertEqual(
+            set(crateLayer.GetCompositionAssetDependencies()),
+            expected - set(["ref_2.usda"]))
+
     def test_Traverse(self):
         ''' Tests Sdf.Layer.Traverse '''
 
@@ -0,0 +1,513 @@
+#include <pxr/sdf/pxr.h>
+#include <pxr/sdf/attributeSpec.h>
+#include <pxr/sdf/changeBlock.h>
+#include <pxr/sdf/layer.h>
+#include <pxr/sdf/notice.h>
+#include <pxr/sdf/path.h>
+#include <pxr/sdf/primSpec.h>
+#include <pxr/sdf/schema.h>
+#include <pxr/sdf/relationshipSpec.h>
+#include <pxr/sdf/types.h>
+
+#include <pxr/ar/defaultResolverContext.h>
+#include <pxr/ar/resolverContextBinder.h>
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/fileUtils.h>
+#include <pxr/tf/pathUtils.h>
+#include <pxr/tf/stringUtils.h>
+#include <pxr/work/loops.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+SDF_NAMESPACE_USING_DIRECTIVE
+
+// Build a layer with a few levels of prims, properties, relationship targets,
+// connections and variants.
+static SdfLayerRefPtr
+_MakeTestLayer()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous(".usda");
+    layer->ImportFromString(R"usda(#usda 1.0
+        def "A" {
+            int a = 1
+            int b.connect = </A.a>
+            rel r = [</A/B>, </A/C>]
+            def "B" {
+                def "D" {
+                    double x = 1.0
+                }
+            }
+            def "C" (
+                variantSets = "v"
+            ) {
+                variantSet "v" = {
+                    "one" {
+                        def "E" {
+                            token t = "one"
+                        }
+                    }
+                    "two" {
+                    }
+                }
+            }
+        }
+        over "F" {
+            def "G" {
+            }
+        }
+    )usda");
+
+    // Wide level to exercise task spawning.
+    SdfPrimSpecHandle wide = SdfPrimSpec::New(
+        layer, "Wide", SdfSpecifierDef);
+    for (int i = 0; i != 256; ++i) {
+        SdfPrimSpecHandle child = SdfPrimSpec::New(
+            wide, TfStringPrintf("Child_%d", i), SdfSpecifierDef);
+        SdfAttributeSpec::New(child, "value", SdfValueTypeNames->Int);
+    }
+    return layer;
+}
+
+static void
+_TestParallelTraverse()
+{
+    printf("_TestParallelTraverse...\n");
+
+    SdfLayerRefPtr layer = _MakeTestLayer();
+
+    SdfPathVector expected;
+    layer->Traverse(SdfPath::AbsoluteRootPath(),
+                    [&expected](const SdfPath &path) {
+                        expected.push_back(path);
+                    });
+    std::sort(expected.begin(), expected.end());
+
+    // Full traversal visits the same specs as the serial traversal.
+    std::mutex mutex;
+    SdfPathVector visited;
+    TF_AXIOM(layer->ParallelTraverse(
+        SdfPath::AbsoluteRootPath(),
+        [&mutex, &visited](const SdfPath &path) {
+            std::lock_guard<std::mutex> lock(mutex);
+            visited.push_back(path);
+            return true;
+        }));
+    std::sort(visited.begin(), visited.end());
+    TF_AXIOM(visited == expected);
+
+    // Pruning skips descendants of the pruned spec but visits the spec.
+    const SdfPath prunePath("/A");
+    visited.clear();
+    TF_AXIOM(layer->ParallelTraverse(
+        SdfPath::AbsoluteRootPath(),
+        [&mutex, &visited, &prunePath](const SdfPath &path) {
+            std::lock_guard<std::mutex> lock(mutex);
+            visited.push_back(path);
+            return path != prunePath;
+        }));
+    std::sort(visited.begin(), visited.end());
+
+    SdfPathVector expectedPruned;
+    std::copy_if(expected.begin(), expected.end(),
+                 std::back_inserter(expectedPruned),
+                 [&prunePath](const SdfPath &path) {
+                     return path == prunePath || !path.HasPrefix(prunePath);
+                 });
+    TF_AXIOM(visited == expectedPruned);
+
+    // Cancellation stops the traversal early and is reported.
+    std::atomic<bool> cancel(false);
+    std::atomic<size_t> numVisited(0);
+    TF_AXIOM(!layer->ParallelTraverse(
+        SdfPath::AbsoluteRootPath(),
+        [&cancel, &numVisited](const SdfPath &path) {
+            if (++numVisited == 10) {
+                cancel = true;
+            }
+            return true;
+        }, &cancel));
+    TF_AXIOM(numVisited < expected.size());
+
+    // A pre-cancelled traversal visits nothing.
+    numVisited = 0;
+    TF_AXIOM(!layer->ParallelTraverse(
+        SdfPath::AbsoluteRootPath(),
+        [&numVisited](const SdfPath &) {
+            ++numVisited;
+            return true;
+        }, &cancel));
+    TF_AXIOM(numVisited == 0);
+}
+
+static void
+_TestFindOrOpenMany()
+{
+    printf("_TestFindOrOpenMany...\n");
+
+    SdfLayerRefPtr source = _MakeTestLayer();
+
+    std::vector<std::string> identifiers;
+    for (int i = 0; i != 16; ++i) {
+        const std::string path = TfStringPrintf("findOrOpenMany_%d.usda", i);
+        TF_AXIOM(source->Export(path));
+        identifiers.push_back(path);
+    }
+
+    // Keep one layer open beforehand so it is found in the registry.
+    SdfLayerRefPtr existing = SdfLayer::FindOrOpen(identifiers[3]);
+    TF_AXIOM(existing);
+
+    // Add duplicate and unresolvable identifiers.
+    identifiers.push_back(identifiers[0]);
+    identifiers.push_back("./" + identifiers[1]);
+    identifiers.push_back("findOrOpenMany_missing.usda");
+
+    std::vector<std::string> errors;
+    SdfLayerRefPtrVector layers = SdfLayer::FindOrOpenMany(
+        identifiers, SdfLayer::FileFormatArguments(), &errors);
+    TF_AXIOM(layers.size() == identifiers.size());
+    TF_AXIOM(errors.size() == identifiers.size());
+
+    for (size_t i = 0; i != 16; ++i) {
+        TF_AXIOM(layers[i]);
+        TF_AXIOM(layers[i] == SdfLayer::Find(identifiers[i]));
+        TF_AXIOM(layers[i]->GetPrimAtPath(SdfPath("/A/B/D")));
+        TF_AXIOM(errors[i].empty());
+    }
+    TF_AXIOM(layers[3] == existing);
+    TF_AXIOM(layers[16] == layers[0]);
+    TF_AXIOM(layers[17] == layers[1]);
+    TF_AXIOM(!layers.back());
+
+    // Three spellings of one file, none open yet: the first opens the
+    // layer, the second resolves to it, and the third has the same
+    // identifier as the second, so all three must get the layer.
+    const std::string spelled = "findOrOpenMany_spelled.usda";
+    TF_AXIOM(source->Export(spelled));
+    const std::vector<std::string> spellings = {
+        spelled, "./" + spelled, TfAbsPath(spelled) };
+    layers = SdfLayer::FindOrOpenMany(spellings);
+    TF_AXIOM(layers.size() == 3);
+    TF_AXIOM(layers[0]);
+    TF_AXIOM(layers[1] == layers[0]);
+    TF_AXIOM(layers[2] == layers[0]);
+
+    // An identifier that only resolves through the caller's resolver context
+    // must resolve in the tasks that open it too.
+    const std::string searchDir = "findOrOpenManyContext";
+    const std::string inContext = "findOrOpenMany_inContext.usda";
+    TF_AXIOM(TfMakeDirs(searchDir, -1, /* existOk = */ true));
+    TF_AXIOM(source->Export(TfStringCatPaths(searchDir, inContext)));
+    layers = SdfLayer::FindOrOpenMany(
+        { inContext }, SdfLayer::FileFormatArguments(), &errors);
+    TF_AXIOM(layers.size() == 1 && !layers[0]);
+    {
+        ArResolverContextBinder binder(
+            ArDefaultResolverContext({ TfAbsPath(searchDir) }));
+        layers = SdfLayer::FindOrOpenMany(
+            { inContext }, SdfLayer::FileFormatArguments(), &errors);
+    }
+    TF_AXIOM(layers.size() == 1 && layers[0]);
+    TF_AXIOM(layers[0]->GetPrimAtPath(SdfPath("/A/B/D")));
+    TF_AXIOM(errors[0].empty());
+}
+
+static void
+_TestConcurrentFindOrOpen()
+{
+    printf("_TestConcurrentFindOrOpen...\n");
+
+    SdfLayerRefPtr source = _MakeTestLayer();
+
+    std::vector<std::string> identifiers;
+    for (int i = 0; i != 8; ++i) {
+        const std::string path = TfStringPrintf("concurrentFind_%d.usda", i);
+        TF_AXIOM(source->Export(path));
+        identifiers.push_back(path);
+    }
+
+    // Keep half of the layers alive, so threads race between finding open
+    // layers and opening, releasing and destroying the others.
+    SdfLayerRefPtrVector held;
+    for (size_t i = 0; i < identifiers.size(); i += 2) {
+        held.push_back(SdfLayer::FindOrOpen(identifiers[i]));
+        TF_AXIOM(held.back());
+    }
+
+    WorkParallelForN(4096, [&identifiers](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            const std::string &identifier = identifiers[i % identifiers.size()];
+            SdfLayerRefPtr layer = SdfLayer::FindOrOpen(identifier);
+            TF_AXIOM(layer);
+            TF_AXIOM(layer->GetPrimAtPath(SdfPath("/A/B/D")));
+            TF_AXIOM(SdfLayer::Find(identifier) == layer);
+        }
+    }, /*grainSize=*/1);
+
+    for (size_t i = 0; i < identifiers.size(); i += 2) {
+        TF_AXIOM(SdfLayer::Find(identifiers[i]) == held[i / 2]);
+    }
+}
+
+static void
+_TestRemoveInertSceneDescription()
+{
+    printf("_TestRemoveInertSceneDescription...\n");
+
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous(".usda");
+    layer->ImportFromString(R"usda(#usda 1.0
+        over "Empty" {
+            over "Child" {
+            }
+        }
+        over "Mixed" {
+            over "Inert" {
+            }
+            def "Def" {
+            }
+        }
+        over "WithVariants" (
+            variantSets = "v"
+        ) {
+            variantSet "v" = {
+                "one" {
+                    over "InVariant" {
+                    }
+                }
+            }
+        }
+        def "Defined" {
+            over "Inert" {
+            }
+            over "WithValue" {
+                int a = 1
+            }
+        }
+    )usda");
+
+    // Add a wide level of inert and non-inert prims.
+    SdfPrimSpecHandle wide =
+        SdfPrimSpec::New(layer, "Wide", SdfSpecifierDef);
+    for (int i = 0; i != 256; ++i) {
+        SdfPrimSpec::New(wide, TfStringPrintf("Child_%d", i),
+                         i % 2 ? SdfSpecifierOver : SdfSpecifierDef);
+    }
+
+    layer->RemoveInertSceneDescription();
+
+    TF_AXIOM(!layer->GetPrimAtPath(SdfPath("/Empty")));
+    TF_AXIOM(!layer->GetPrimAtPath(SdfPath("/Mixed/Inert")));
+    TF_AXIOM(layer->GetPrimAtPath(SdfPath("/Mixed/Def")));
+    TF_AXIOM(layer->GetPrimAtPath(SdfPath("/WithVariants")));
+    TF_AXIOM(!layer->GetPrimAtPath(SdfPath("/WithVariants{v=one}InVariant")));
+    TF_AXIOM(!layer->GetPrimAtPath(SdfPath("/Defined/Inert")));
+    TF_AXIOM(layer->GetPrimAtPath(SdfPath("/Defined/WithValue")));
+    TF_AXIOM(wide->GetNameChildren().size() == 128);
+    for (const SdfPrimSpecHandle &child : wide->GetNameChildren()) {
+        TF_AXIOM(child->GetSpecifier() == SdfSpecifierDef);
+    }
+}
+
+static void
+_TestSharedChangeBlock()
+{
+    printf("_TestSharedChangeBlock...\n");
+
+    struct Listener : public TfWeakBase
+    {
+        void LayersDidChange(const SdfNotice::LayersDidChange &n)
+        {
+            ++rounds;
+            changes = n.GetChangeListVec();
+        }
+
+        size_t rounds = 0;
+        SdfLayerChangeListVec changes;
+    };
+
+    SdfLayerRefPtrVector layers;
+    for (int i = 0; i != 64; ++i) {
+        layers.push_back(SdfLayer::CreateAnonymous());
+    }
+    SdfLayerRefPtr overlapping = SdfLayer::CreateAnonymous();
+    SdfPrimSpecHandle prim = SdfCreatePrimInLayer(overlapping, SdfPath("/P"));
+
+    Listener listener;
+    TfNotice::Key key = TfNotice::Register(
+        TfCreateWeakPtr(&listener), &Listener::LayersDidChange);
+
+    {
+        SdfSharedChangeBlock shared;
+
+        WorkParallelForN(layers.size(),
+            [&layers, &shared](size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    SdfChangeBlock block(shared);
+                    SdfCreatePrimInLayer(layers[i], SdfPath("/Prim"));
+                }
+            }, /*grainSize=*/1);
+
+        // Separate blocks changing the same path are merged.
+        {
+            SdfChangeBlock block(shared);
+            prim->SetDocumentation("first");
+        }
+        {
+            SdfChangeBlock block(shared);
+            prim->SetDocumentation("second");
+            prim->SetComment("comment");
+        }
+
+        TF_AXIOM(listener.rounds == 0);
+    }
+
+    TF_AXIOM(listener.rounds == 1);
+    TF_AXIOM(listener.changes.size() == layers.size() + 1);
+    for (const auto &layerAndChanges : listener.changes) {
+        if (layerAndChanges.first == overlapping) {
+            const SdfChangeList::Entry &entry =
+                layerAndChanges.second.GetEntry(SdfPath("/P"));
+            const auto docChange =
+                entry.FindInfoChange(SdfFieldKeys->Documentation);
+            TF_AXIOM(docChange != entry.infoChanged.end());
+            TF_AXIOM(docChange->second.first.IsEmpty());
+            TF_AXIOM(docChange->second.second ==
+                     VtValue(std::string("second")));
+            TF_AXIOM(entry.HasInfoChange(SdfFieldKeys->Comment));
+        }
+        else {
+            TF_AXIOM(layerAndChanges.second.GetEntry(
+                SdfPath("/Prim")).flags.didAddInertPrim);
+        }
+    }
+
+    TfNotice::Revoke(key);
+}
+
+static void
+_TestConcurrentFieldReads()
+{
+    printf("_TestConcurrentFieldReads...\n");
+
+    SdfLayerRefPtr layer = _MakeTestLayer();
+    const size_t numChildren = 256;
+    SdfPathVector attrPaths;
+    for (size_t i = 0; i != numChildren; ++i) {
+        attrPaths.push_back(SdfPath(
+            TfStringPrintf("/Wide/Child_%zu.value", i)));
+        layer->SetField(attrPaths.back(), SdfFieldKeys->Default,
+                        VtValue(static_cast<int>(i)));
+    }
+
+    // GetFieldRaw reads authored values only, and reports value blocks
+    // only when asked for them.
+    int intValue = 0;
+    TF_AXIOM(layer->GetFieldRaw(attrPaths[7], SdfFieldKeys->Default,
+                                &intValue));
+    TF_AXIOM(intValue == 7);
+    double doubleValue = 0.0;
+    TF_AXIOM(!layer->GetFieldRaw(attrPaths[7], SdfFieldKeys->Default,
+                                 &doubleValue));
+    TF_AXIOM(!layer->GetFieldRaw(SdfPath("/Missing.value"),
+                                 SdfFieldKeys->Default, &intValue));
+    TF_AXIOM(layer->GetFieldRaw(attrPaths[7], SdfFieldKeys->Default,
+                                static_cast<int *>(nullptr)));
+    TF_AXIOM(!layer->GetFieldRaw(SdfPath("/Missing.value"),
+                                 SdfFieldKeys->Default,
+                                 static_cast<int *>(nullptr)));
+    layer->SetField(SdfPath("/A.a"), SdfFieldKeys->Default,
+                    VtValue(SdfValueBlock()));
+    SdfValueBlock block;
+    TF_AXIOM(!layer->GetFieldRaw(SdfPath("/A.a"), SdfFieldKeys->Default,
+                                 &intValue));
+    TF_AXIOM(layer->GetFieldRaw(SdfPath("/A.a"), SdfFieldKeys->Default,
+                                &block));
+
+    // Many threads read the same fields of both a text layer and a layer
+    // streaming its data from a usdc file.
+    const std::string crateFile = "testSdfLayerThreading_reads.usdc";
+    TF_AXIOM(layer->Export(crateFile));
+    SdfLayerRefPtr crateLayer = SdfLayer::FindOrOpen(crateFile);
+    TF_AXIOM(crateLayer);
+
+    for (const SdfLayerRefPtr &readLayer : { layer, crateLayer }) {
+        std::atomic<size_t> numErrors(0);
+        WorkParallelForN(
+            numChildren * 64,
+            [&readLayer, &attrPaths, &numErrors, numChildren](
+                size_t begin, size_t end) {
+                for (size_t i = begin; i != end; ++i) {
+                    const size_t index = i % numChildren;
+                    const SdfPath &path = attrPaths[index];
+                    int value = -1;
+                    if (!readLayer->GetFieldRaw(
+                            path, SdfFieldKeys->Default, &value) ||
+                        value != static_cast<int>(index) ||
+                        readLayer->GetField(path, SdfFieldKeys->Default) !=
+                            VtValue(value) ||
+                        !readLayer->HasField(
+                            path.GetPrimPath(), SdfFieldKeys->Specifier)) {
+                        ++numErrors;
+                    }
+                }
+            }, 1);
+        TF_AXIOM(numErrors == 0);
+    }
+}
+
+static void
+_TestConcurrentChangeJournal()
+{
+    printf("_TestConcurrentChangeJournal...\n");
+
+    // Edit the layer and enable, resize and disable its change journal on
+    // one thread while others read the journal.
+    SdfLayerRefPtr layer = _MakeTestLayer();
+    const SdfPath attrPath("/Wide/Child_0.value");
+    std::atomic<bool> done(false);
+    std::thread writer([&layer, &attrPath, &done]() {
+        for (int i = 0; i != 2000; ++i) {
+            layer->SetChangeJournalLimit(i % 3 * 4);
+            layer->SetField(attrPath, SdfFieldKeys->Default, VtValue(i));
+        }
+        done = true;
+    });
+
+    std::atomic<size_t> numErrors(0);
+    WorkParallelForN(
+        8,
+        [&layer, &done, &numErrors](size_t begin, size_t end) {
+            std::vector<SdfLayer::ChangeJournalRound> rounds;
+            while (!done) {
+                const size_t limit = layer->GetChangeJournalLimit();
+                if (limit != 0 && limit != 4 && limit != 8) {
+                    ++numErrors;
+                }
+                rounds.clear();
+                if (layer->GetJournaledChangesSince(0, &rounds) &&
+                    rounds.size() > 8) {
+                    ++numErrors;
+                }
+            }
+        }, 1);
+    writer.join();
+    TF_AXIOM(numErrors == 0);
+}
+
+int main(int argc, char **argv)
+{
+    _TestParallelTraverse();
+    _TestFindOrOpenMany();
+    _TestConcurrentFindOrOpen();
+    _TestRemoveInertSceneDescription();
+    _TestSharedChangeBlock();
+    _TestConcurrentFieldReads();
+    _TestConcurrentChangeJournal();
+
+    printf(">>> Test SUCCEEDED\n");
+    return 0;
+}
@@ -8,9 +8,12 @@
 #include <iostream>
 #include <cassert>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 #include <pxr/sdf/pxr.h>
 #include <pxr/sdf/path.h>
+#include <pxr/sdf/pathParser.h>
 #include <pxr/tf/diagnostic.h>
 #include <pxr/tf/stringUtils.h>
 
@@ -49,6 +52,68 @@ void testPaths(char const *paths[], bool expectEmpty) {
     }
 }
 
+// Check that \p result, from a parse that may take the scanner for plain
+// absolute paths, matches what the full grammar makes of \p str.
+void checkAgainstGrammar(std::string const &str, SdfPath const &result,
+                         char const *what) {
+    SdfPath expected;
+    std::string errMsg;
+    if (!Sdf_ParsePathWithGrammar(str, &expected, &errMsg)) {
+        expected = SdfPath();
+    }
+    if (result != expected) {
+        TF_FATAL_ERROR("%s mismatch for <%s>: <%s> but grammar gives <%s>",
+                       what, TfEscapeString(str).c_str(), result.GetText(),
+                       expected.GetText());
+    }
+}
+
+void testParseMany(char const *good[], char const *bad[]) {
+
+    // Strings near the shapes the scanner accepts, so that anything it
+    // accepts or rejects differently from the grammar shows up.
+    std::vector<std::string> strings = {
+        "", "/", "//", "/a/", "/a//b", "/a.", "/a.b:", "/a.b::c", "/a..b",
+        "/a.b.c", "/a:b", "/a/:b", "/1a", "/a/1b", "/a.1b", "/a.b:1c",
+        "/_", "/_1", "/a_1/B2.c_3:d4", "/a.b:c:d:e", "/a b", "/a\t", "/a\n",
+        " /a", "/a ", "/a.b ", "/a-b", "/a.b-c", "/a.b[/c]", "/a{v=x}",
+        "/a/b{v=x}c", "/a.b[/c].d", "/a.expression", "/a.mapper",
+        "/a\x7f", "/a\x80", "/\xc3\xa4", "/a.\xc3\xa4", "/a/\xc3\xa4" "b",
+        "a", "a/b", ".a", "./a", "../a", "/a/..", "/a/.", "/.",
+        std::string("/a\0b", 4), std::string("/a.b\0", 5),
+    };
+
+    // Long paths and names longer than the scanner's token buffer.
+    std::string deep;
+    for (int i = 0; i != 64; ++i) {
+        deep += TfStringPrintf("/Prim_%d", i);
+    }
+    strings.push_back(deep);
+    strings.push_back(deep + ".attr:ns");
+    strings.push_back(deep + "/");
+    strings.push_back("/" + std::string(200, 'a') + "." +
+                      std::string(200, 'b') + ":" + std::string(31, 'c'));
+
+    // Interleave good and bad strings so that a bulk parse has to keep
+    // each result in its own slot.
+    for (char const **g = good, **b = bad; *g || *b; ) {
+        if (*g) strings.push_back(*g++);
+        if (*b) strings.push_back(*b++);
+    }
+
+    for (std::string const &str: strings) {
+        checkAgainstGrammar(str, SdfPath(str), "SdfPath");
+    }
+
+    const SdfPathVector result = SdfPath::ParseMany(strings);
+    TF_AXIOM(result.size() == strings.size());
+    for (size_t i = 0; i != strings.size(); ++i) {
+        checkAgainstGrammar(strings[i], result[i], "ParseMany");
+    }
+
+    TF_AXIOM(SdfPath::ParseMany({}).empty());
+}
+
 int main()
 {
 
@@ -216,6 +281,9 @@ int main()
     printf("Testing bad paths: errors expected\n");
     testPaths(bad, 1);
 
+    printf("Testing scanner against grammar: errors expected\n");
+    testParseMany(good, bad);
+
     printf("Done expecting errors\n");
 
     printf("Test PASSED\n");
@@ -0,0 +1,205 @@
+#include <pxr/sdf/pxr.h>
+#include <pxr/sdf/pathPrefixMapper.h>
+#include <pxr/sdf/path.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+SDF_NAMESPACE_USING_DIRECTIVE
+
+static bool
+_Maps(SdfPathPrefixMapper const &mapper,
+      char const *path, char const *expected)
+{
+    const SdfPath result = mapper.Map(SdfPath(path));
+    if (result != SdfPath(expected)) {
+        printf("ERROR: <%s> mapped to <%s>, expected <%s>\n",
+               path, result.GetText(), expected);
+        return false;
+    }
+    return true;
+}
+
+static void
+_TestSingleReplacement()
+{
+    // With a single replacement the mapper agrees with ReplacePrefix.
+    const SdfPath oldPrefix("/A/B");
+    const SdfPath newPrefix("/X/Y/Z");
+    const char *paths[] = {
+        "/", "/A", "/A/B", "/A/B/C", "/A/BB", "/Q/A/B", "/A/B/C.attr",
+        "/A/B{v=x}C/D.attr", "/A.rel[/A/B/C]", "/A/B.rel[/A/B/C].attr",
+        "/Q.rel[/A/B].attr", "/A/B.attr.mapper[/A/B/C.x]",
+        "/A/B.attr.mapper[/A/B/C.x].arg", "/A/B.attr.expression",
+    };
+    for (const bool fixTargetPaths: { true, false }) {
+        const SdfPathPrefixMapper mapper(oldPrefix, newPrefix, fixTargetPaths);
+        TF_AXIOM(mapper.GetNumReplacements() == 1);
+        for (char const *pathStr: paths) {
+            const SdfPath path(pathStr);
+            TF_AXIOM(!path.IsEmpty());
+            const SdfPath expected =
+                path.ReplacePrefix(oldPrefix, newPrefix, fixTargetPaths);
+            TF_AXIOM(_Maps(mapper, pathStr, expected.GetText()));
+        }
+    }
+
+    // Property prefixes work too.
+    const SdfPathPrefixMapper propMapper(SdfPath("/A.rel"), SdfPath("/X.rel"));
+    TF_AXIOM(_Maps(propMapper, "/A.rel[/B].attr", "/X.rel[/B].attr"));
+    TF_AXIOM(_Maps(propMapper, "/A.relative", "/A.relative"));
+    TF_AXIOM(_Maps(propMapper, "/A", "/A"));
+}
+
+static void
+_TestNestedReplacements()
+{
+    const SdfPathPrefixMapper mapper({
+        { SdfPath("/A"), SdfPath("/X") },
+        { SdfPath("/A/B"), SdfPath("/Y") },
+        { SdfPath("/A/B/C"), SdfPath("/A/B/C") },
+        { SdfPath("/A/D"), SdfPath() },
+    });
+    TF_AXIOM(mapper.GetNumReplacements() == 4);
+    TF_AXIOM(mapper.FindReplacement(SdfPath("/A/B")) &&
+             *mapper.FindReplacement(SdfPath("/A/B")) == SdfPath("/Y"));
+    TF_AXIOM(!mapper.FindReplacement(SdfPath("/A/B/E")));
+
+    // The longest old prefix wins.
+    TF_AXIOM(_Maps(mapper, "/A", "/X"));
+    TF_AXIOM(_Maps(mapper, "/A/F.attr", "/X/F.attr"));
+    TF_AXIOM(_Maps(mapper, "/A/B", "/Y"));
+    TF_AXIOM(_Maps(mapper, "/A/B/E/F", "/Y/E/F"));
+    TF_AXIOM(_Maps(mapper, "/A/B/C/D", "/A/B/C/D"));
+    TF_AXIOM(_Maps(mapper, "/Q/A/B", "/Q/A/B"));
+
+    // Targets are mapped by their own longest prefix.
+    TF_AXIOM(_Maps(mapper, "/A.rel[/A/B/t]", "/X.rel[/Y/t]"));
+    TF_AXIOM(_Maps(mapper, "/Q.rel[/A/B/C/t].attr", "/Q.rel[/A/B/C/t].attr"));
+    TF_AXIOM(_Maps(mapper, "/Q.attr.mapper[/A/E.x].arg",
+                   "/Q.attr.mapper[/X/E.x].arg"));
+
+    // An empty new prefix maps everything under it, including paths that
+    // target it, to the empty path.
+    TF_AXIOM(mapper.Map(SdfPath("/A/D")).IsEmpty());
+    TF_AXIOM(mapper.Map(SdfPath("/A/D/E.attr")).IsEmpty());
+    TF_AXIOM(mapper.Map(SdfPath("/Q.rel[/A/D/E]")).IsEmpty());
+
+    // Relative and empty paths are left alone.
+    TF_AXIOM(_Maps(mapper, "A/B", "A/B"));
+    TF_AXIOM(_Maps(mapper, "../A/B", "../A/B"));
+    TF_AXIOM(mapper.Map(SdfPath()).IsEmpty());
+
+    // Without target fixing targets keep their paths.
+    const SdfPathPrefixMapper noTargets({
+        { SdfPath("/A"), SdfPath("/X") },
+        { SdfPath("/A/B"), SdfPath("/Y") },
+    }, /*fixTargetPaths=*/false);
+    TF_AXIOM(_Maps(noTargets, "/A.rel[/A/B/t]", "/X.rel[/A/B/t]"));
+    TF_AXIOM(_Maps(noTargets, "/Q.rel[/A/B/t]", "/Q.rel[/A/B/t]"));
+
+    // Mapping the absolute root maps every absolute path.
+    const SdfPathPrefixMapper rootMapper(SdfPath::AbsoluteRootPath(),
+                                         SdfPath("/Root"));
+    TF_AXIOM(_Maps(rootMapper, "/", "/Root"));
+    TF_AXIOM(_Maps(rootMapper, "/A/B.attr", "/Root/A/B.attr"));
+    TF_AXIOM(_Maps(rootMapper, "/A.rel[/B]", "/Root/A.rel[/Root/B]"));
+
+    // An empty mapper maps every path to itself.
+    const SdfPathPrefixMapper empty;
+    TF_AXIOM(empty.IsEmpty());
+    TF_AXIOM(_Maps(empty, "/A/B", "/A/B"));
+}
+
+static void
+_TestInvalidReplacements()
+{
+    TfErrorMark m;
+    const SdfPathPrefixMapper mapper({
+        { SdfPath("A/B"), SdfPath("/X") },
+        { SdfPath(), SdfPath("/X") },
+        { SdfPath("/A"), SdfPath("/X") },
+        { SdfPath("/A"), SdfPath("/Y") },
+    });
+    size_t numErrors = 0;
+    m.GetBegin(&numErrors);
+    TF_AXIOM(numErrors == 3);
+    m.Clear();
+
+    // Only the first valid replacement is kept.
+    TF_AXIOM(mapper.GetNumReplacements() == 1);
+    TF_AXIOM(_Maps(mapper, "/A/B", "/X/B"));
+    TF_AXIOM(_Maps(mapper, "A/B", "A/B"));
+}
+
+static void
+_TestMapMany()
+{
+    // Build a namespace with properties and targets, mapped by replacements
+    // at several depths.
+    SdfPathVector paths;
+    const char *names[] = { "a", "b", "c", "d" };
+    for (char const *n0: names) {
+        const SdfPath p0 = SdfPath::AbsoluteRootPath().AppendChild(TfToken(n0));
+        paths.push_back(p0);
+        for (char const *n1: names) {
+            const SdfPath p1 = p0.AppendChild(TfToken(n1));
+            paths.push_back(p1);
+            for (char const *n2: names) {
+                const SdfPath p2 = p1.AppendChild(TfToken(n2));
+                paths.push_back(p2);
+                for (char const *n3: names) {
+                    const SdfPath p3 = p2.AppendChild(TfToken(n3));
+                    paths.push_back(p3);
+                    paths.push_back(p3.AppendProperty(TfToken("x")));
+                    paths.push_back(p3.AppendProperty(TfToken("rel"))
+                                    .AppendTarget(p1));
+                }
+            }
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    const SdfPathPrefixMapper mapper({
+        { SdfPath("/a"), SdfPath("/m") },
+        { SdfPath("/a/b"), SdfPath("/n/o") },
+        { SdfPath("/b/c/d"), SdfPath("/p") },
+        { SdfPath("/c/a/a/a.x"), SdfPath("/c/a/a/a.y") },
+    });
+
+    // Repeat the paths enough to be split across threads, and check both
+    // sorted and shuffled input, which rarely repeats parents.
+    SdfPathVector input;
+    for (int i = 0; i != 10; ++i) {
+        input.insert(input.end(), paths.begin(), paths.end());
+    }
+    for (int pass = 0; pass != 2; ++pass) {
+        const SdfPathVector result = mapper.MapMany(input);
+        TF_AXIOM(result.size() == input.size());
+        for (size_t i = 0; i != input.size(); ++i) {
+            TF_AXIOM(result[i] == mapper.Map(input[i]));
+        }
+        std::shuffle(input.begin(), input.end(), std::mt19937(100));
+    }
+
+    TF_AXIOM(_Maps(mapper, "/a/b/c.rel[/b/c/d/a]", "/n/o/c.rel[/p/a]"));
+    TF_AXIOM(_Maps(mapper, "/c/a/a/a.x", "/c/a/a/a.y"));
+    TF_AXIOM(mapper.MapMany(SdfPathVector()).empty());
+}
+
+int
+main(int argc, char **argv)
+{
+    _TestSingleReplacement();
+    _TestNestedReplacements();
+    _TestInvalidReplacements();
+    _TestMapMany();
+
+    printf(">>> Test SUCCEEDED\n");
+    return 0;
+}
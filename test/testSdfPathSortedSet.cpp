@@ -0,0 +1,201 @@
+#include <pxr/sdf/pxr.h>
+#include <pxr/sdf/pathSortedSet.h>
+#include <pxr/sdf/path.h>
+
+#include <pxr/tf/diagnostic.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+SDF_NAMESPACE_USING_DIRECTIVE
+
+static const size_t npos = SdfPathSortedSet::npos;
+
+// Return a random path of up to four prims, sometimes with a property, drawn
+// from a small namespace so that random sets nest often.
+static SdfPath
+_RandomPath()
+{
+    static const char *names[] = { "a", "b", "c" };
+    SdfPath path = SdfPath::AbsoluteRootPath();
+    for (int depth = rand() % 5; depth; --depth) {
+        path = path.AppendChild(TfToken(names[rand() % 3]));
+    }
+    if (path.IsPrimPath() && rand() % 4 == 0) {
+        path = path.AppendProperty(TfToken(names[rand() % 3]));
+    }
+    return path;
+}
+
+static SdfPathSet
+_RandomPathSet(size_t maxSize)
+{
+    SdfPathSet result;
+    for (size_t i = rand() % (maxSize + 1); i; --i) {
+        result.insert(_RandomPath());
+    }
+    return result;
+}
+
+// Check \p set against \p expected, including its recorded structure.
+static void
+_CheckSet(SdfPathSortedSet const &set, SdfPathSet const &expected)
+{
+    TF_AXIOM(set.size() == expected.size());
+    TF_AXIOM(std::equal(set.begin(), set.end(), expected.begin()));
+
+    for (size_t i = 0; i != set.size(); ++i) {
+        TF_AXIOM(set.Find(set[i]) == i);
+        TF_AXIOM(set.GetDepth(i) == set[i].GetPathElementCount());
+
+        // The parent is the nearest strict ancestor in the set.
+        const SdfPathSet::const_iterator parent =
+            SdfPathFindLongestStrictPrefix(expected, set[i]);
+        TF_AXIOM(parent == expected.end()
+                 ? set.GetParentIndex(i) == npos
+                 : set[set.GetParentIndex(i)] == *parent);
+
+        // The subtree ends at the first path without the prefix.
+        size_t end = i + 1;
+        while (end != set.size() && set[end].HasPrefix(set[i])) {
+            ++end;
+        }
+        TF_AXIOM(set.GetSubtreeEnd(i) == end);
+    }
+}
+
+static void
+_TestBasics()
+{
+    const SdfPathSortedSet empty;
+    TF_AXIOM(empty.empty());
+    TF_AXIOM(empty.FindLongestPrefix(SdfPath("/a")) == npos);
+    TF_AXIOM(empty.FindSubtreeRange(SdfPath("/a")).first ==
+             empty.FindSubtreeRange(SdfPath("/a")).second);
+
+    // Unsorted input with duplicates.
+    const SdfPathSortedSet set {
+        SdfPath("/a/b"), SdfPath("/a"), SdfPath("/c.x"), SdfPath("/a/b/c"),
+        SdfPath("/a"), SdfPath("/b"), SdfPath("/a/b.y")
+    };
+    TF_AXIOM(set.size() == 6);
+    TF_AXIOM(set[0] == SdfPath("/a"));
+    TF_AXIOM(set.Contains(SdfPath("/a/b.y")));
+    TF_AXIOM(!set.Contains(SdfPath("/a/c")));
+
+    TF_AXIOM(set[set.FindLongestPrefix(SdfPath("/a/b/d"))] ==
+             SdfPath("/a/b"));
+    TF_AXIOM(set[set.FindLongestPrefix(SdfPath("/a/b"))] == SdfPath("/a/b"));
+    TF_AXIOM(set[set.FindLongestStrictPrefix(SdfPath("/a/b"))] ==
+             SdfPath("/a"));
+    TF_AXIOM(set[set.FindLongestPrefix(SdfPath("/a/c/d"))] == SdfPath("/a"));
+    TF_AXIOM(set.FindLongestPrefix(SdfPath("/c")) == npos);
+    TF_AXIOM(set.FindLongestPrefix(SdfPath("a/b")) == npos);
+    TF_AXIOM(set.ContainsPrefixOf(SdfPath("/c.x")));
+
+    const std::pair<size_t, size_t> range =
+        set.FindSubtreeRange(SdfPath("/a/b"));
+    TF_AXIOM(range.second - range.first == 3);
+    TF_AXIOM(set.FindSubtreeRange(SdfPath::AbsoluteRootPath()).second ==
+             set.size());
+
+    TF_AXIOM(set.GetRoots() == SdfPathSortedSet({
+                SdfPath("/a"), SdfPath("/b"), SdfPath("/c.x") }));
+    TF_AXIOM(set.GetLeaves() == SdfPathSortedSet({
+                SdfPath("/a/b/c"), SdfPath("/a/b.y"), SdfPath("/b"),
+                SdfPath("/c.x") }));
+
+    SdfPathVector roots = set.GetPaths();
+    SdfPath::RemoveDescendentPaths(&roots);
+    TF_AXIOM(roots == set.GetRoots().GetPaths());
+    SdfPathVector leaves = set.GetPaths();
+    SdfPath::RemoveAncestorPaths(&leaves);
+    TF_AXIOM(leaves == set.GetLeaves().GetPaths());
+}
+
+static void
+_TestRandom()
+{
+    for (size_t iter = 0; iter != 500; ++iter) {
+        const SdfPathSet lhs = _RandomPathSet(40), rhs = _RandomPathSet(10);
+        const SdfPathSortedSet lhsSet(
+            SdfPathVector(lhs.rbegin(), lhs.rend()));
+        const SdfPathSortedSet rhsSet =
+            SdfPathSortedSet::FromSorted(SdfPathVector(rhs.begin(), rhs.end()));
+        _CheckSet(lhsSet, lhs);
+        _CheckSet(rhsSet, rhs);
+
+        for (size_t i = 0; i != 20; ++i) {
+            const SdfPath path = _RandomPath();
+
+            const SdfPathSet::const_iterator prefix =
+                SdfPathFindLongestPrefix(lhs, path);
+            const size_t index = lhsSet.FindLongestPrefix(path);
+            TF_AXIOM(prefix == lhs.end()
+                     ? index == npos : lhsSet[index] == *prefix);
+
+            const SdfPathSet::const_iterator strictPrefix =
+                SdfPathFindLongestStrictPrefix(lhs, path);
+            const size_t strictIndex = lhsSet.FindLongestStrictPrefix(path);
+            TF_AXIOM(strictPrefix == lhs.end()
+                     ? strictIndex == npos
+                     : lhsSet[strictIndex] == *strictPrefix);
+
+            const auto expectedRange =
+                SdfPathFindPrefixedRange(lhs.begin(), lhs.end(), path);
+            const std::pair<size_t, size_t> range =
+                lhsSet.FindSubtreeRange(path);
+            TF_AXIOM(range.first ==
+                     size_t(std::distance(lhs.begin(), expectedRange.first)));
+            TF_AXIOM(range.second ==
+                     size_t(std::distance(lhs.begin(), expectedRange.second)));
+        }
+
+        SdfPathSet unionSet, intersection, difference;
+        std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                       std::inserter(unionSet, unionSet.end()));
+        std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                              std::inserter(intersection, intersection.end()));
+        std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                            std::inserter(difference, difference.end()));
+        _CheckSet(SdfPathSortedSet::Union(lhsSet, rhsSet), unionSet);
+        _CheckSet(SdfPathSortedSet::Intersection(lhsSet, rhsSet),
+                  intersection);
+        _CheckSet(SdfPathSortedSet::Difference(lhsSet, rhsSet), difference);
+
+        SdfPathSet withPrefix, withoutPrefix;
+        for (SdfPath const &path: lhs) {
+            if (SdfPathFindLongestPrefix(rhs, path) != rhs.end()) {
+                withPrefix.insert(path);
+            } else {
+                withoutPrefix.insert(path);
+            }
+        }
+        _CheckSet(lhsSet.GetPathsWithPrefixIn(rhsSet), withPrefix);
+        _CheckSet(lhsSet.GetPathsWithoutPrefixIn(rhsSet), withoutPrefix);
+
+        SdfPathVector roots(lhs.begin(), lhs.end());
+        SdfPath::RemoveDescendentPaths(&roots);
+        _CheckSet(lhsSet.GetRoots(), SdfPathSet(roots.begin(), roots.end()));
+        SdfPathVector leaves(lhs.begin(), lhs.end());
+        SdfPath::RemoveAncestorPaths(&leaves);
+        _CheckSet(lhsSet.GetLeaves(), SdfPathSet(leaves.begin(), leaves.end()));
+    }
+}
+
+int
+main()
+{
+    srand(100);
+
+    _TestBasics();
+    _TestRandom();
+
+    printf(">>> Test SUCCEEDED\n");
+    return 0;
+}
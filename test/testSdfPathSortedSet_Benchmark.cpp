@@ -0,0 +1,119 @@
+#include <pxr/sdf/pxr.h>
+#include <pxr/sdf/pathSortedSet.h>
+#include <pxr/sdf/path.h>
+
+#include <pxr/tf/diagnostic.h>
+#include <pxr/tf/stopwatch.h>
+#include <pxr/tf/stringUtils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+SDF_NAMESPACE_USING_DIRECTIVE
+
+// Compare prefix queries and bulk operations against std::set<SdfPath> on a
+// generated namespace shaped like a large scene.
+static void
+_RunBenchmark()
+{
+    // Every other mesh is a prefix.
+    SdfPathVector paths, prefixPaths;
+    for (int i = 0; i != 100; ++i) {
+        const SdfPath group = SdfPath::AbsoluteRootPath().AppendChild(
+            TfToken(TfStringPrintf("Group_%d", i)));
+        paths.push_back(group);
+        for (int j = 0; j != 100; ++j) {
+            const SdfPath prim = group.AppendChild(
+                TfToken(TfStringPrintf("Mesh_%d", j)));
+            paths.push_back(prim);
+            if (j % 2 == 0) {
+                prefixPaths.push_back(prim);
+            }
+            for (int k = 0; k != 8; ++k) {
+                paths.push_back(prim.AppendProperty(
+                    TfToken(TfStringPrintf("attr_%d", k))));
+            }
+        }
+    }
+    std::shuffle(paths.begin(), paths.end(), std::mt19937(100));
+
+    printf("Benchmark: %zu paths, %zu prefixes\n",
+           paths.size(), prefixPaths.size());
+
+    TfStopwatch sw;
+    size_t found = 0;
+
+    sw.Start();
+    const SdfPathSet stdSet(paths.begin(), paths.end());
+    const SdfPathSet stdPrefixes(prefixPaths.begin(), prefixPaths.end());
+    sw.Stop();
+    printf("  std::set build:           %8.3f ms\n", sw.GetMilliseconds());
+
+    sw.Reset();
+    sw.Start();
+    const SdfPathSortedSet sortedSet(paths);
+    const SdfPathSortedSet sortedPrefixes(prefixPaths);
+    sw.Stop();
+    printf("  SdfPathSortedSet build:   %8.3f ms\n", sw.GetMilliseconds());
+
+    sw.Reset();
+    sw.Start();
+    for (SdfPath const &path: paths) {
+        found += SdfPathFindLongestPrefix(stdPrefixes, path) !=
+            stdPrefixes.end();
+    }
+    sw.Stop();
+    printf("  std::set longest prefix:  %8.3f ms\n", sw.GetMilliseconds());
+
+    sw.Reset();
+    sw.Start();
+    for (SdfPath const &path: paths) {
+        found -= sortedPrefixes.ContainsPrefixOf(path);
+    }
+    sw.Stop();
+    printf("  sorted set longest prefix:%8.3f ms\n", sw.GetMilliseconds());
+    TF_AXIOM(found == 0);
+
+    sw.Reset();
+    sw.Start();
+    SdfPathVector stdRoots(stdSet.begin(), stdSet.end());
+    SdfPath::RemoveDescendentPaths(&stdRoots);
+    sw.Stop();
+    printf("  RemoveDescendentPaths:    %8.3f ms\n", sw.GetMilliseconds());
+
+    sw.Reset();
+    sw.Start();
+    const SdfPathSortedSet roots = sortedSet.GetRoots();
+    sw.Stop();
+    printf("  GetRoots:                 %8.3f ms\n", sw.GetMilliseconds());
+    TF_AXIOM(roots.GetPaths() == stdRoots);
+
+    sw.Reset();
+    sw.Start();
+    SdfPathSet stdWithout;
+    for (SdfPath const &path: stdSet) {
+        if (SdfPathFindLongestPrefix(stdPrefixes, path) == stdPrefixes.end()) {
+            stdWithout.insert(stdWithout.end(), path);
+        }
+    }
+    sw.Stop();
+    printf("  std::set prefix removal:  %8.3f ms\n", sw.GetMilliseconds());
+
+    sw.Reset();
+    sw.Start();
+    const SdfPathSortedSet without =
+        sortedSet.GetPathsWithoutPrefixIn(sortedPrefixes);
+    sw.Stop();
+    printf("  GetPathsWithoutPrefixIn:  %8.3f ms\n", sw.GetMilliseconds());
+    TF_AXIOM(std::equal(without.begin(), without.end(),
+                        stdWithout.begin(), stdWithout.end()));
+}
+
+int
+main()
+{
+    _RunBenchmark();
+    return 0;
+}
@@ -12,12 +12,15 @@
 #include <pxr/tf/stringUtils.h>
 #include <pxr/tf/stopwatch.h>
 #include <pxr/tf/diagnostic.h>
+#include <pxr/tf/errorMark.h>
 #include <pxr/tf/hashmap.h>
+#include <pxr/arch/demangle.h>
 #include <pxr/arch/fileSystem.h>
 
 #include <algorithm>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 #include <utility>
 
@@ -288,6 +291,177 @@ static void DoUnitTest()
     TF_AXIOM(table.find(SdfPath("/a2/a2/a2/a2")).HasChild() == false);
 }
 
+static void DoInsertManyTest()
+{
+    typedef SdfPathTable<string> Table;
+
+    SdfPathVector paths;
+    for (int i = 0; i != 20; ++i) {
+        const SdfPath prim(TfStringPrintf("/Group_%d/Mesh", i % 7));
+        paths.push_back(prim.AppendChild(TfToken(TfStringPrintf("c%d", i))));
+        paths.push_back(prim.AppendProperty(TfToken("points")));
+    }
+    std::sort(paths.begin(), paths.end());
+
+    // Bulk insertion into an empty table adds the same entries as inserting
+    // one at a time, and lays them out in iteration order.
+    Table expected;
+    for (SdfPath const &path: paths) {
+        expected[path];
+    }
+    Table table;
+    TF_AXIOM(table.InsertMany(paths) == expected.size());
+    TF_AXIOM(table.size() == expected.size());
+    for (Table::const_iterator i = expected.begin(); i != expected.end(); ++i) {
+        TF_AXIOM(table.count(i->first));
+    }
+    Table::value_type const *prev = nullptr;
+    for (Table::value_type const &value: table) {
+        TF_AXIOM(!prev || prev < &value);
+        prev = &value;
+    }
+
+    // Subtree ranges cover exactly the prefixed paths.
+    for (SdfPath const &path: paths) {
+        const SdfPath group = path.GetPrefixes().front();
+        size_t count = 0;
+        auto range = table.FindSubtreeRange(group);
+        for (Table::iterator i = range.first; i != range.second; ++i) {
+            TF_AXIOM(i->first.HasPrefix(group));
+            ++count;
+        }
+        size_t expectedCount = 0;
+        for (Table::value_type const &value: expected) {
+            expectedCount += value.first.HasPrefix(group);
+        }
+        TF_AXIOM(count == expectedCount);
+    }
+
+    // Existing entries keep their values, and new entries attach to
+    // existing parents.
+    table[SdfPath("/Group_1/Mesh")] = "keep";
+    const SdfPathVector morePaths = {
+        SdfPath("/Group_1/Mesh"), SdfPath("/Group_1/Mesh/extra"),
+        SdfPath("/Other/x")
+    };
+    TF_AXIOM(table.InsertMany(morePaths) == 3);
+    TF_AXIOM(table[SdfPath("/Group_1/Mesh")] == "keep");
+    TF_AXIOM(table.find(SdfPath("/Group_1/Mesh")).HasChild());
+    TF_AXIOM(table.count(SdfPath("/Other")));
+    TF_AXIOM(table.InsertMany(morePaths) == 0);
+
+    // Erasing block entries and copying the table still work.
+    const size_t sizeBefore = table.size();
+    TF_AXIOM(table.erase(SdfPath("/Group_1")));
+    TF_AXIOM(table.size() < sizeBefore);
+    TF_AXIOM(!table.count(SdfPath("/Group_1/Mesh/extra")));
+    Table copy(table);
+    TF_AXIOM(copy.size() == table.size());
+    table.clear();
+    TF_AXIOM(table.empty());
+
+    // Reinserting restores everything but /Other and /Other/x.
+    copy.InsertMany(paths);
+    TF_AXIOM(copy.size() == expected.size() + 2);
+}
+
+
+static void DoSnapshotTest()
+{
+    struct Value {
+        int index;
+        float weight;
+    };
+    typedef SdfPathTable<Value> Table;
+
+    Table table;
+    for (int i = 0; i != 50; ++i) {
+        const SdfPath prim(TfStringPrintf("/Root/Group_%d/Prim_%d", i % 5, i));
+        table[prim] = Value { i, i * 0.5f };
+        table[prim.AppendProperty(TfToken("points"))] = Value { -i, 1.0f };
+        table[prim.AppendVariantSelection("lod", "high").AppendChild(
+                TfToken("Detail"))] = Value { i, 2.0f };
+    }
+
+    const string fileName = "testSdfPathTableSnapshot.bin";
+    TF_AXIOM(table.WriteSnapshot(fileName));
+
+    // Reading replaces the existing contents and preserves iteration order.
+    Table loaded;
+    loaded[SdfPath("/Stale")] = Value { 0, 0.0f };
+    TF_AXIOM(loaded.ReadSnapshot(fileName));
+    TF_AXIOM(loaded.size() == table.size());
+    TF_AXIOM(!loaded.count(SdfPath("/Stale")));
+    Table::const_iterator j = loaded.begin();
+    for (Table::const_iterator i = table.begin(); i != table.end(); ++i, ++j) {
+        TF_AXIOM(i->first == j->first);
+        TF_AXIOM(i->second.index == j->second.index);
+        TF_AXIOM(i->second.weight == j->second.weight);
+    }
+    TF_AXIOM(j == loaded.end());
+    TF_AXIOM(loaded.find(SdfPath("/Root/Group_3/Prim_8.points"))
+             ->second.index == -8);
+
+    // A snapshot of another value type is rejected, leaving the table alone.
+    SdfPathTable<int> other;
+    other[SdfPath("/Keep")] = 1;
+    {
+        TfErrorMark mark;
+        TF_AXIOM(!other.ReadSnapshot(fileName));
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+    }
+    TF_AXIOM(other.size() == 2);
+
+    // Snapshots whose counts exceed the file, or that repeat a path, are
+    // rejected.
+    {
+        Table small;
+        small[SdfPath("/A/B")] = Value { 1, 1.0f };
+        TF_AXIOM(small.WriteSnapshot(fileName));
+        FILE *file = fopen(fileName.c_str(), "rb");
+        std::vector<char> bytes(1024);
+        bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+        fclose(file);
+
+        // The path and token counts follow the magic, version and value
+        // size.
+        for (const size_t offset: { 16, 24 }) {
+            std::vector<char> corrupt = bytes;
+            const uint64_t huge = uint64_t(1) << 40;
+            memcpy(corrupt.data() + offset, &huge, sizeof(huge));
+            file = fopen(fileName.c_str(), "wb");
+            fwrite(corrupt.data(), 1, corrupt.size(), file);
+            fclose(file);
+
+            TfErrorMark mark;
+            TF_AXIOM(!small.ReadSnapshot(fileName));
+            TF_AXIOM(!mark.IsClean());
+            mark.Clear();
+            TF_AXIOM(small.size() == 3);
+        }
+
+        const SdfPathVector duplicates = {
+            SdfPath("/"), SdfPath("/A"), SdfPath("/A/B"), SdfPath("/A")
+        };
+        const Value values[4] = {};
+        TF_AXIOM(Sdf_WritePathTableSnapshot(
+                     fileName, duplicates, values, sizeof(Value),
+                     ArchGetDemangled<Value>()));
+        TfErrorMark mark;
+        TF_AXIOM(!small.ReadSnapshot(fileName));
+        TF_AXIOM(!mark.IsClean());
+        mark.Clear();
+        TF_AXIOM(small.size() == 3);
+    }
+
+    // An empty table round-trips.
+    TF_AXIOM(Table().WriteSnapshot(fileName));
+    TF_AXIOM(loaded.ReadSnapshot(fileName));
+    TF_AXIOM(loaded.empty());
+
+    ArchUnlinkFile(fileName.c_str());
+}
 
 static void ReadPaths(string const &fileName, vector<SdfPath> *out)
 {
@@ -393,6 +567,8 @@ main(int argc, char **argv)
                 "pathsFile\n", TfGetBaseName(argv[0]).c_str());
         fprintf(stderr, "running unit test.\n");
         DoUnitTest();
+        DoInsertManyTest();
+        DoSnapshotTest();
         exit(0);
     }
 
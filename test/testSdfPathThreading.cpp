@@ -13,6 +13,7 @@
 #include <pxr/tf/pxrCLI11/CLI11.h>
 #include <pxr/tf/stringUtils.h>
 
+#include <algorithm>
 #include <atomic>
 #include <ctime>
 #include <cstdlib>
@@ -174,6 +175,90 @@ static TfStopwatch _DoPathOperations()
     return sw;
 }
 
+// Return unused pool memory while other threads create and drop paths, so
+// that spans are released under lookups that may still be reading them.
+static void _DoPoolReleases()
+{
+    TfStopwatch sw;
+    while (static_cast<size_t>(sw.GetMilliseconds()) < msecsToRun) {
+        sw.Start();
+        SdfPathReleaseUnusedPoolMemory();
+        std::this_thread::yield();
+        sw.Stop();
+    }
+}
+
+// Re-create paths that already exist, the common case when re-reading layers
+// or evaluating path expressions, on 1, 2, 4, ... numThreads threads and report
+// the throughput at each thread count.  The working set is larger than the
+// per-thread path caches in SdfPath so that lookups reach the node tables.
+static void _RunScalingBenchmark()
+{
+    static const size_t numNames = 256;
+    TfTokenVector names;
+    for (size_t i = 0; i != numNames; ++i) {
+        names.push_back(TfToken(TfStringPrintf("scale_%zu", i)));
+    }
+
+    // Hold every path so each lookup finds an existing node.
+    SdfPathVector existing;
+    existing.reserve(numNames * numNames * 2);
+    for (TfToken const &parentName: names) {
+        const SdfPath parent =
+            SdfPath::AbsoluteRootPath().AppendChild(parentName);
+        for (TfToken const &childName: names) {
+            const SdfPath child = parent.AppendChild(childName);
+            existing.push_back(child);
+            existing.push_back(child.AppendProperty(childName));
+        }
+    }
+
+    printf("Scaling: re-creating %zu existing paths\n", existing.size());
+    const size_t maxThreads = std::max<size_t>(numThreads, 1);
+    double singleThreadRate = 0.0;
+    for (size_t n = 1; ; n = std::min(n * 2, maxThreads)) {
+        std::atomic<size_t> numOps(0);
+        const auto work = [&names, &numOps](size_t offset) {
+            TfStopwatch sw;
+            size_t ops = 0;
+            sw.Start();
+            for (size_t i = offset; ; ++i) {
+                const SdfPath parent = SdfPath::AbsoluteRootPath()
+                    .AppendChild(names[i % numNames]);
+                for (TfToken const &childName: names) {
+                    const SdfPath child = parent.AppendChild(childName);
+                    TF_AXIOM(child.AppendProperty(childName).IsPropertyPath());
+                }
+                ops += 2 * numNames + 1;
+                sw.Stop();
+                if (static_cast<size_t>(sw.GetMilliseconds()) >= msecsToRun) {
+                    break;
+                }
+                sw.Start();
+            }
+            numOps += ops;
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i != n; ++i) {
+            workers.emplace_back(work, i * (numNames / n));
+        }
+        for (std::thread &t: workers) {
+            t.join();
+        }
+
+        const double rate = double(numOps) / (double(msecsToRun) / 1000.0);
+        if (n == 1) {
+            singleThreadRate = rate;
+        }
+        printf("  %3zu thread%s: %12.0f ops/sec (%.2fx)\n", n,
+               n > 1 ? "s" : " ", rate, rate / singleThreadRate);
+        if (n == maxThreads) {
+            break;
+        }
+    }
+}
+
 int main(int argc, char const **argv)
 {
     // Set up arguments and their defaults
@@ -184,9 +269,18 @@ int main(int argc, char const **argv)
         ->default_val(std::thread::hardware_concurrency());
     app.add_option("--msec", msecsToRun, "Milliseconds to run")
         ->default_val(2000);
+    bool scaling = false;
+    app.add_flag("--scaling", scaling,
+                 "Report lookup throughput from 1 to numThreads threads");
 
     CLI11_PARSE(app, argc, argv);
 
+    if (scaling) {
+        printf("Using %zu threads\n", numThreads);
+        _RunScalingBenchmark();
+        return 0;
+    }
+
     // Initialize. 
     srand(randomSeed);
     printf("Using random seed: %d\n", randomSeed);
@@ -200,6 +294,7 @@ int main(int argc, char const **argv)
     for (size_t i = 0; i < numThreads; ++i) {
         workers.emplace_back(_DoPathOperations);
     }
+    workers.emplace_back(_DoPoolReleases);
 
     std::for_each(workers.begin(), workers.end(), 
                   [](std::thread& t) { t.join(); });
@@ -9,12 +9,19 @@
 #include <pxr/sdf/fileFormat.h>
 #include <pxr/sdf/fileIO.h>
 #include <pxr/sdf/fileVersion.h>
+#include <pxr/sdf/attributeSpec.h>
+#include <pxr/sdf/layer.h>
+#include <pxr/sdf/primSpec.h>
+#include <pxr/sdf/schema.h>
 #include <pxr/sdf/usdaFileFormat.h>
 
 #include <pxr/tf/diagnostic.h>
 #include <pxr/tf/envSetting.h>
+#include <pxr/tf/stringUtils.h>
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 SDF_NAMESPACE_USING_DIRECTIVE
 
@@ -205,6 +212,97 @@ bool TestUpdate()
 }
 
 
+bool TestCapture()
+{
+    bool ok = true;
+
+    SdfFileFormatConstPtr usdaFormat = SdfFileFormat::FindByExtension("usda");
+    std::string cookie = usdaFormat->GetFileCookie();
+
+    const SdfFileVersion ver110{1, 1, 0};
+
+    Sdf_StringOutput out;
+    out.WriteHeader(cookie, SdfFileVersion{1, 0, 0});
+    out.Write("before\n");
+
+    std::string captured;
+    out.BeginCapture(&captured);
+    out.Write("captured\n");
+    out.RequestWriteVersionUpgrade(ver110, "Upgrading while capturing.");
+    SdfFileVersion capturedVersion;
+    std::string reason;
+    out.EndCapture(&capturedVersion, &reason);
+
+    out.Write("after\n");
+
+    ok &= TF_VERIFY(captured == "captured\n",
+                    "Captured: '%s'\n", captured.c_str());
+    ok &= TF_VERIFY(capturedVersion == ver110);
+    ok &= TF_VERIFY(reason == "Upgrading while capturing.");
+
+    const std::string contents = out.GetString();
+    const std::string expected =
+        cookie + " " + ver110.AsString() + "\nbefore\ncaptured\nafter\n";
+    ok &= TF_VERIFY(contents == expected,
+                    "    Contents: '%s'\n"
+                    "    Expected: '%s'\n",
+                    contents.c_str(), expected.c_str());
+
+    return ok;
+}
+
+static std::string
+_ReadFile(const std::string& path)
+{
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool TestRepeatedSave()
+{
+    bool ok = true;
+
+    const std::string path = "testSdfTextFile_repeatedSave.usda";
+    SdfLayerRefPtr layer = SdfLayer::CreateNew(path);
+    for (int i = 0; i != 8; ++i) {
+        SdfPrimSpecHandle prim = SdfPrimSpec::New(
+            layer, TfStringPrintf("Prim_%d", i), SdfSpecifierDef);
+        SdfAttributeSpec::New(prim, "value", SdfValueTypeNames->Int)
+            ->SetDefaultValue(VtValue(i));
+    }
+    ok &= TF_VERIFY(layer->Save());
+
+    // Each save writes the same text as a full serialization, including
+    // after edits to a few root prims.
+    std::string expected;
+    ok &= TF_VERIFY(layer->ExportToString(&expected));
+    ok &= TF_VERIFY(_ReadFile(path) == expected);
+
+    layer->GetAttributeAtPath(SdfPath("/Prim_3.value"))
+        ->SetDefaultValue(VtValue(42));
+    layer->GetPrimAtPath(SdfPath("/Prim_5"))->SetDocumentation("edited");
+    layer->GetPrimAtPath(SdfPath("/Prim_1"))->SetName("Renamed");
+    SdfPrimSpec::New(
+        layer->GetPrimAtPath(SdfPath("/Prim_7")), "Child", SdfSpecifierOver);
+    layer->SetDocumentation("layer doc");
+    ok &= TF_VERIFY(layer->Save());
+
+    ok &= TF_VERIFY(layer->ExportToString(&expected));
+    ok &= TF_VERIFY(_ReadFile(path) == expected);
+    ok &= TF_VERIFY(expected.find("42") != std::string::npos);
+
+    // Reloading replaces the layer's data.
+    ok &= TF_VERIFY(layer->Reload(/*force=*/true));
+    layer->GetPrimAtPath(SdfPath("/Prim_0"))->SetComment("comment");
+    ok &= TF_VERIFY(layer->Save());
+    ok &= TF_VERIFY(layer->ExportToString(&expected));
+    ok &= TF_VERIFY(_ReadFile(path) == expected);
+
+    return ok;
+}
+
 int
 main(int argc, char** argv)
 {
@@ -214,6 +312,8 @@ main(int argc, char** argv)
 
     ok &= TF_VERIFY(TestHeader(), "TestHeader failed.");
     ok &= TF_VERIFY(TestUpdate(), "TestUpdate failed.");
+    ok &= TF_VERIFY(TestCapture(), "TestCapture failed.");
+    ok &= TF_VERIFY(TestRepeatedSave(), "TestRepeatedSave failed.");
 
     return (ok ? 0 : 1);
 }